@@ -5,9 +5,10 @@
 
 /* FILE:        def.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 22.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base defines header file.
- * NOTE:        None.
+ * NOTE:        Renderer scalar type 'REAL' is double by default and float
+ *              when built with PIRT_FLOAT (CMake option T05RT_FLOAT).
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -242,32 +243,44 @@ recurse:
         } /* End of 'Walk' function */
     }; /* End of 'stock' class */
 
+  /* Renderer scalar type */
+#ifdef PIRT_FLOAT
+  typedef FLT REAL;
+#else  // PIRT_FLOAT
+  typedef DBL REAL;
+#endif // PIRT_FLOAT
+
   /* Vec2 declare types */
-  typedef mth::vec2<DBL>  vec2;
+  typedef mth::vec2<REAL> vec2;
   typedef mth::vec2<FLT>  fvec2;
   typedef mth::vec2<INT>  ivec2;
   typedef mth::vec2<BOOL> bvec2;
 
   /* Vec3 declare types */
-  typedef mth::vec3<DBL>  vec3;
+  typedef mth::vec3<REAL> vec3;
   typedef mth::vec3<FLT>  fvec3;
   typedef mth::vec3<INT>  ivec3;
   typedef mth::vec3<BOOL> bvec3;
 
   /* Vec4 declare types */
-  typedef mth::vec4<DBL>  vec4;
+  typedef mth::vec4<REAL> vec4;
   typedef mth::vec4<FLT>  fvec4;
   typedef mth::vec4<INT>  ivec4;
   typedef mth::vec4<BOOL> bvec4;
 
   /* Matrix declare types */
-  typedef mth::matr<DBL>  matr;
+  typedef mth::matr<REAL> matr;
   typedef mth::matr<FLT>  fmatr;
   typedef mth::matr<INT>  imatr;
   typedef mth::matr<BOOL> bmatr;
 
-  typedef mth::ray<DBL> ray;
-  typedef mth::camera<DBL> camera;
+  typedef mth::ray<REAL> ray;
+  typedef mth::ray_diff<REAL> ray_diff;
+  typedef mth::camera<REAL> camera;
+
+  /* Structure of arrays batches declare types */
+  typedef mth::vec3_batch<REAL> vec3_batch;
+  typedef mth::ray_batch<REAL> ray_batch;
 } /* end of 'pirt' namespace */
 
 
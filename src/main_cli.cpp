@@ -0,0 +1,46 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        main_cli.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     Headless (command line) renderer main file.
+ * NOTE:        None.
+ * 
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "pirt.h"
+#include "rt/rt_cli.h"
+
+/* Console application main function.
+ * ARGUMENTS:
+ *   - command line arguments count:
+ *       INT Argc;
+ *   - command line arguments:
+ *       CHAR **Argv;
+ * RETURNS:
+ *   (INT) application exit code.
+ */
+INT main( INT Argc, CHAR **Argv )
+{
+  pirt::rt::rt_cli Cli;
+
+  if (!Cli.ParseArgs(Argc, Argv))
+  {
+    pirt::rt::rt_cli::Usage(Argv[0]);
+    return 2;
+  }
+  if (Cli.IsHelp)
+  {
+    pirt::rt::rt_cli::Usage(Argv[0]);
+    return 0;
+  }
+
+  return Cli.Run();
+} /* End of 'main' function */
+
+/* END OF 'main_cli.cpp' FILE */
@@ -5,7 +5,7 @@
 
 /* FILE:        mth.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 21.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math header file.
  * NOTE:        None.
  * 
@@ -23,6 +23,7 @@
 #include "mth_matr.h"
 #include "mth_camera.h"
 #include "mth_ray.h"
+#include "mth_batch.h"
 
 #endif // !__mth_h_
 
@@ -0,0 +1,213 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_batch.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     Base math vectors and rays batches header file.
+ * NOTE:        Batches keep components by structure of arrays, so
+ *              matrix transforms them by SIMD width items at once.
+ *              Hit batches are vectors batches of points and normals.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_batch_h_
+#define __mth_batch_h_
+
+#include <vector>
+#include <cmath>
+
+#include "mth_simd.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* 3D vectors batch (structure of arrays) class */
+  template<typename Type>
+    class vec3_batch
+    {
+    public:
+      std::vector<Type> X, Y, Z; // Components arrays
+
+      /* Get items count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) items count.
+       */
+      INT Size( VOID ) const
+      {
+        return (INT)X.size();
+      } /* End of 'Size' function */
+
+      /* Remove all items function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Clear( VOID )
+      {
+        X.clear();
+        Y.clear();
+        Z.clear();
+      } /* End of 'Clear' function */
+
+      /* Add item function.
+       * ARGUMENTS:
+       *   - vector:
+       *       const vec3<Type> &V;
+       * RETURNS: None.
+       */
+      VOID Push( const vec3<Type> &V )
+      {
+        X.push_back(V.X);
+        Y.push_back(V.Y);
+        Z.push_back(V.Z);
+      } /* End of 'Push' function */
+
+      /* Get item function.
+       * ARGUMENTS:
+       *   - item number:
+       *       INT No;
+       * RETURNS:
+       *   (vec3<Type>) vector.
+       */
+      vec3<Type> Get( INT No ) const
+      {
+        return vec3<Type>(X[No], Y[No], Z[No]);
+      } /* End of 'Get' function */
+
+      /* Transform items as points function.
+       * ARGUMENTS:
+       *   - matrix:
+       *       const matr<Type> &M;
+       * RETURNS: None.
+       */
+      VOID TransformPoints( const matr<Type> &M )
+      {
+        M.TransformPoints(X.data(), Y.data(), Z.data(), Size());
+      } /* End of 'TransformPoints' function */
+
+      /* Transform items as vectors (without translation) function.
+       * ARGUMENTS:
+       *   - matrix:
+       *       const matr<Type> &M;
+       * RETURNS: None.
+       */
+      VOID TransformVectors( const matr<Type> &M )
+      {
+        M.TransformVectors(X.data(), Y.data(), Z.data(), Size());
+      } /* End of 'TransformVectors' function */
+
+      /* Transform items as normals (by inverse transpose matrix) function.
+       * ARGUMENTS:
+       *   - matrix:
+       *       const matr<Type> &M;
+       * RETURNS: None.
+       */
+      VOID TransformNormals( const matr<Type> &M )
+      {
+        M.TransformNormals(X.data(), Y.data(), Z.data(), Size());
+      } /* End of 'TransformNormals' function */
+
+      /* Normalize items function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Normalize( VOID )
+      {
+        Type *x = X.data(), *y = Y.data(), *z = Z.data();
+
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          simd::NormalizeBatch(x, y, z, Size());
+          return;
+        }
+        // Same operations as single vector normalization
+        for (INT i = 0, n = Size(); i < n; i++)
+        {
+          Type Len = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+
+          x[i] /= Len;
+          y[i] /= Len;
+          z[i] /= Len;
+        }
+      } /* End of 'Normalize' function */
+    }; /* End of 'vec3_batch' class */
+
+  /* Rays batch (structure of arrays) class */
+  template<typename Type>
+    class ray_batch
+    {
+    public:
+      vec3_batch<Type> Org, Dir; // Origins and directions
+
+      /* Get rays count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) rays count.
+       */
+      INT Size( VOID ) const
+      {
+        return Org.Size();
+      } /* End of 'Size' function */
+
+      /* Remove all rays function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Clear( VOID )
+      {
+        Org.Clear();
+        Dir.Clear();
+      } /* End of 'Clear' function */
+
+      /* Add ray function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray<Type> &R;
+       * RETURNS: None.
+       */
+      VOID Push( const ray<Type> &R )
+      {
+        Org.Push(R.Org);
+        Dir.Push(R.Dir);
+      } /* End of 'Push' function */
+
+      /* Get ray function.
+       * ARGUMENTS:
+       *   - ray number:
+       *       INT No;
+       * RETURNS:
+       *   (ray<Type>) ray.
+       */
+      ray<Type> Get( INT No ) const
+      {
+        ray<Type> R;
+
+        // Directions are kept normalized (as by ray constructor)
+        R.Org = Org.Get(No);
+        R.Dir = Dir.Get(No);
+        return R;
+      } /* End of 'Get' function */
+
+      /* Transform rays (directions are normalized) function.
+       * ARGUMENTS:
+       *   - matrix:
+       *       const matr<Type> &M;
+       * RETURNS: None.
+       */
+      VOID Transform( const matr<Type> &M )
+      {
+        Org.TransformPoints(M);
+        Dir.TransformVectors(M);
+        Dir.Normalize();
+      } /* End of 'Transform' function */
+    }; /* End of 'ray_batch' class */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_batch_h_
+
+/* END OF 'mth_batch.h' FILE */
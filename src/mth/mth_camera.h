@@ -5,7 +5,7 @@
 
 /* FILE:        mth_camera.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 21.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math camera header file.
  * NOTE:        None.
  * 
@@ -61,6 +61,34 @@ namespace mth
         return ray<Type>(Loc + Q, Q);
       } /* End of 'FrameRay' function */
 
+      /* Get frame ray with differentials function.
+       * ARGUMENTS:
+       *   - source coordinates:
+       *       Type Xs, Ys;
+       *   - ray differentials (by one pixel step) to be set:
+       *       ray_diff<Type> *Diff;
+       * RETURNS:
+       *   ray<Type> new ray.
+       */
+      ray<Type> FrameRay( Type Xs, Type Ys, ray_diff<Type> *Diff ) const
+      {
+        vec3<Type>
+          Q =
+            Dir * ProjDist +
+            Right * ((Xs - FrameW / 2) * Wp / FrameW) +
+            Up * ((FrameH / 2 - Ys) * Hp / FrameH),
+          dQdx = Right * (Wp / FrameW),
+          dQdy = Up * (-Hp / FrameH);
+        Type Len2 = Q & Q, Len = sqrt(Len2);
+
+        // Derivative of Q / |Q|: (dQ * (Q, Q) - Q * (Q, dQ)) / |Q|^3
+        Diff->dOdx = dQdx;
+        Diff->dOdy = dQdy;
+        Diff->dDdx = (dQdx * Len2 - Q * (Q & dQdx)) / (Len2 * Len);
+        Diff->dDdy = (dQdy * Len2 - Q * (Q & dQdy)) / (Len2 * Len);
+        return ray<Type>(Loc + Q, Q);
+      } /* End of 'FrameRay' function */
+
       /* Default constructor */
       camera( VOID ) :
         Loc(0, 0, 5), Dir(0, 0, -1), Up(0, 1, 0), Right(1, 0, 0), At(0, 0, 0),
@@ -5,7 +5,7 @@
 
 /* FILE:        mth_def.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 22.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math defines header file.
  * NOTE:        None.
  * 
@@ -20,6 +20,8 @@
 #include <cstring>
 #include <iostream>
 #include <cassert>
+
+#ifdef _WIN32
 #include <intrin.h>
 
 #ifndef WIN32
@@ -30,6 +32,23 @@
 #include <commondf.h>
 #endif // !WIN32
 
+/* Disable function inlining specifier */
+#define MTH_NOINLINE __declspec(noinline)
+#else  // _WIN32
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif // __x86_64__ || __i386__
+#include "port/port_def.h"
+
+/* Disable function inlining specifier */
+#define MTH_NOINLINE __attribute__((noinline))
+#endif // _WIN32
+
+/* AVX instructions usage flag (MSVC allows intrinsics without /arch) */
+#if defined(_MSC_VER) || defined(__AVX__)
+#define MTH_USE_AVX
+#endif // _MSC_VER || __AVX__
+
 /* Short version of float types */
 typedef float FLT;
 typedef double DBL;
@@ -69,6 +88,7 @@ namespace mth
   template<typename Type> class vec4;
   template<typename Type> class matr;
   template<typename Type> class ray;
+  template<typename Type> class ray_diff;
   template<typename Type> class camera;
 } /* end of 'mth' namespace */
 
@@ -5,9 +5,11 @@
 
 /* FILE:        mth_matr.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 22.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math matrix header file.
- * NOTE:        None.
+ * NOTE:        Double and float matrices multiplication and transforms use
+ *              SIMD kernels (see 'mth_simd.h'). Batch transformations
+ *              work with structure of arrays (separate X, Y, Z arrays).
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -16,7 +18,7 @@
 #ifndef __mth_matr_h_
 #define __mth_matr_h_
 
-#include "mth_def.h"
+#include "mth_simd.h"
 
 /* Space math namespace */
 namespace mth
@@ -31,7 +33,14 @@ namespace mth
    *       const DBL *msrc2;
    * RETURNS: None.
    */ 
+#ifdef _WIN64
   extern "C" VOID MatrMulMatr( DBL *mdst, const DBL *msrc1, const DBL *msrc2 );
+#else  // _WIN64
+  inline VOID MatrMulMatr( DBL *mdst, const DBL *msrc1, const DBL *msrc2 )
+  {
+    simd::MatrMulMatr(mdst, msrc1, msrc2);
+  } /* End of 'MatrMulMatr' function */
+#endif // _WIN64
 
   /* Matrix 4x4 type */
   template<typename Type> 
@@ -42,6 +51,7 @@ namespace mth
     private:
       mutable Type InvM[4][4];        // Inverse matr components.
       mutable BOOL IsInverse = FALSE; // Matr inverse status
+    public:
 
       /* Default constructor */
       matr()
@@ -239,32 +249,40 @@ namespace mth
       /* Multiplicate two matrixes function.
        * ARGUMENTS: 
        *   - second matrix:
-       *       const matr &M;
+       *       const matr &M1;
        * RETURNS:
        *   (MATR) result matrix.
        */
-      matr operator*( const matr &M ) const 
+      matr operator*( const matr &M1 ) const 
       {
-        return
-          matr(M[0][0] * M.M[0][0] + M[0][1] * M.M[1][0] + M[0][2] * M.M[2][0] + M[0][3] * M.M[3][0],
-               M[0][0] * M.M[0][1] + M[0][1] * M.M[1][1] + M[0][2] * M.M[2][1] + M[0][3] * M.M[3][1],
-               M[0][0] * M.M[0][2] + M[0][1] * M.M[1][2] + M[0][2] * M.M[2][2] + M[0][3] * M.M[3][2],
-               M[0][0] * M.M[0][3] + M[0][1] * M.M[1][3] + M[0][2] * M.M[2][3] + M[0][3] * M.M[3][3],
-
-               M[1][0] * M.M[0][0] + M[1][1] * M.M[1][0] + M[1][2] * M.M[2][0] + M[1][3] * M.M[3][0],
-               M[1][0] * M.M[0][1] + M[1][1] * M.M[1][1] + M[1][2] * M.M[2][1] + M[1][3] * M.M[3][1],
-               M[1][0] * M.M[0][2] + M[1][1] * M.M[1][2] + M[1][2] * M.M[2][2] + M[1][3] * M.M[3][2],
-               M[1][0] * M.M[0][3] + M[1][1] * M.M[1][3] + M[1][2] * M.M[2][3] + M[1][3] * M.M[3][3],
-
-               M[2][0] * M.M[0][0] + M[2][1] * M.M[1][0] + M[2][2] * M.M[2][0] + M[2][3] * M.M[3][0],
-               M[2][0] * M.M[0][1] + M[2][1] * M.M[1][1] + M[2][2] * M.M[2][1] + M[2][3] * M.M[3][1],
-               M[2][0] * M.M[0][2] + M[2][1] * M.M[1][2] + M[2][2] * M.M[2][2] + M[2][3] * M.M[3][2],
-               M[2][0] * M.M[0][3] + M[2][1] * M.M[1][3] + M[2][2] * M.M[2][3] + M[2][3] * M.M[3][3],
-
-               M[3][0] * M.M[0][0] + M[3][1] * M.M[1][0] + M[3][2] * M.M[2][0] + M[3][3] * M.M[3][0],
-               M[3][0] * M.M[0][1] + M[3][1] * M.M[1][1] + M[3][2] * M.M[2][1] + M[3][3] * M.M[3][1],
-               M[3][0] * M.M[0][2] + M[3][1] * M.M[1][2] + M[3][2] * M.M[2][2] + M[3][3] * M.M[3][2],
-               M[3][0] * M.M[0][3] + M[3][1] * M.M[1][3] + M[3][2] * M.M[2][3] + M[3][3] * M.M[3][3]);
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          matr C;
+
+          simd::MatrMulMatr(&C.M[0][0], &M[0][0], &M1.M[0][0]);
+          return C;
+        }
+        else
+          return
+            matr(M[0][0] * M1.M[0][0] + M[0][1] * M1.M[1][0] + M[0][2] * M1.M[2][0] + M[0][3] * M1.M[3][0],
+                 M[0][0] * M1.M[0][1] + M[0][1] * M1.M[1][1] + M[0][2] * M1.M[2][1] + M[0][3] * M1.M[3][1],
+                 M[0][0] * M1.M[0][2] + M[0][1] * M1.M[1][2] + M[0][2] * M1.M[2][2] + M[0][3] * M1.M[3][2],
+                 M[0][0] * M1.M[0][3] + M[0][1] * M1.M[1][3] + M[0][2] * M1.M[2][3] + M[0][3] * M1.M[3][3],
+
+                 M[1][0] * M1.M[0][0] + M[1][1] * M1.M[1][0] + M[1][2] * M1.M[2][0] + M[1][3] * M1.M[3][0],
+                 M[1][0] * M1.M[0][1] + M[1][1] * M1.M[1][1] + M[1][2] * M1.M[2][1] + M[1][3] * M1.M[3][1],
+                 M[1][0] * M1.M[0][2] + M[1][1] * M1.M[1][2] + M[1][2] * M1.M[2][2] + M[1][3] * M1.M[3][2],
+                 M[1][0] * M1.M[0][3] + M[1][1] * M1.M[1][3] + M[1][2] * M1.M[2][3] + M[1][3] * M1.M[3][3],
+
+                 M[2][0] * M1.M[0][0] + M[2][1] * M1.M[1][0] + M[2][2] * M1.M[2][0] + M[2][3] * M1.M[3][0],
+                 M[2][0] * M1.M[0][1] + M[2][1] * M1.M[1][1] + M[2][2] * M1.M[2][1] + M[2][3] * M1.M[3][1],
+                 M[2][0] * M1.M[0][2] + M[2][1] * M1.M[1][2] + M[2][2] * M1.M[2][2] + M[2][3] * M1.M[3][2],
+                 M[2][0] * M1.M[0][3] + M[2][1] * M1.M[1][3] + M[2][2] * M1.M[2][3] + M[2][3] * M1.M[3][3],
+
+                 M[3][0] * M1.M[0][0] + M[3][1] * M1.M[1][0] + M[3][2] * M1.M[2][0] + M[3][3] * M1.M[3][0],
+                 M[3][0] * M1.M[0][1] + M[3][1] * M1.M[1][1] + M[3][2] * M1.M[2][1] + M[3][3] * M1.M[3][1],
+                 M[3][0] * M1.M[0][2] + M[3][1] * M1.M[1][2] + M[3][2] * M1.M[2][2] + M[3][3] * M1.M[3][2],
+                 M[3][0] * M1.M[0][3] + M[3][1] * M1.M[1][3] + M[3][2] * M1.M[2][3] + M[3][3] * M1.M[3][3]);
       } /* End of 'operator*' function */
 
       /* Matrix transponce function.
@@ -406,9 +424,17 @@ namespace mth
        */
       vec3<Type> TransformPoint( const vec3<Type> &V ) const
       {
-        return vec3<Type>((V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0] + M[3][0]),
-                          (V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1] + M[3][1]),
-                          (V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2] + M[3][2]));
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          vec3<Type> R;
+
+          simd::TransformPoint(&R.X, &M[0][0], &V.X);
+          return R;
+        }
+        else
+          return vec3<Type>((V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0] + M[3][0]),
+                            (V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1] + M[3][1]),
+                            (V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2] + M[3][2]));
       } /* End of 'TransformPoint' function */
 
       /* Transform vector by Matrix function.
@@ -420,9 +446,17 @@ namespace mth
        */
       vec3<Type> TransformVector( const vec3<Type> &V ) const
       {
-        return vec3<Type>(V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0],
-                          V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1],
-                          V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2]);
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          vec3<Type> R;
+
+          simd::TransformVector(&R.X, &M[0][0], &V.X);
+          return R;
+        }
+        else
+          return vec3<Type>(V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0],
+                            V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1],
+                            V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2]);
       } /* End of 'TransformVector' function */
 
       /* Transform vector by Matrix 4 * 3 function.
@@ -441,6 +475,70 @@ namespace mth
                           V.X * m.M[0][2] + V.Y * m.M[1][2] + V.Z * m.M[2][2]);
       } /* End of 'TransformVector' function */
 
+      /* Transform points batch (structure of arrays) function.
+       * ARGUMENTS:
+       *   - points components arrays (transformed in place):
+       *       Type *X, *Y, *Z;
+       *   - points count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      VOID TransformPoints( Type *X, Type *Y, Type *Z, INT N ) const
+      {
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          simd::TransformBatch(X, Y, Z, N, &M[0][0], TRUE);
+          return;
+        }
+        for (INT i = 0; i < N; i++)
+        {
+          Type x = X[i], y = Y[i], z = Z[i];
+
+          X[i] = x * M[0][0] + y * M[1][0] + z * M[2][0] + M[3][0];
+          Y[i] = x * M[0][1] + y * M[1][1] + z * M[2][1] + M[3][1];
+          Z[i] = x * M[0][2] + y * M[1][2] + z * M[2][2] + M[3][2];
+        }
+      } /* End of 'TransformPoints' function */
+
+      /* Transform vectors batch (structure of arrays) function.
+       * ARGUMENTS:
+       *   - vectors components arrays (transformed in place):
+       *       Type *X, *Y, *Z;
+       *   - vectors count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      VOID TransformVectors( Type *X, Type *Y, Type *Z, INT N ) const
+      {
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          simd::TransformBatch(X, Y, Z, N, &M[0][0], FALSE);
+          return;
+        }
+        for (INT i = 0; i < N; i++)
+        {
+          Type x = X[i], y = Y[i], z = Z[i];
+
+          X[i] = x * M[0][0] + y * M[1][0] + z * M[2][0];
+          Y[i] = x * M[0][1] + y * M[1][1] + z * M[2][1];
+          Z[i] = x * M[0][2] + y * M[1][2] + z * M[2][2];
+        }
+      } /* End of 'TransformVectors' function */
+
+      /* Transform normals batch (structure of arrays) function.
+       * ARGUMENTS:
+       *   - normals components arrays (transformed in place):
+       *       Type *X, *Y, *Z;
+       *   - normals count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      VOID TransformNormals( Type *X, Type *Y, Type *Z, INT N ) const
+      {
+        // Inverse transpose is evaluated once for all normals
+        this->Transpose().Inverse().TransformVectors(X, Y, Z, N);
+      } /* End of 'TransformNormals' function */
+
       /* Transform 4x4 vector function.
        * ARGUMENTS:
        *   - vector:
@@ -464,10 +562,18 @@ namespace mth
        */
       vec4<Type> Transform4x4( const vec4<Type> &V ) const
       {
-        return vec4<Type>((V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0] + V.W * M[3][0]),
-                          (V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1] + V.W * M[3][1]),
-                          (V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2] + V.W * M[3][2]),
-                          (V.X * M[0][3] + V.Y * M[1][3] + V.Z * M[2][3] + V.W * M[3][3]));
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          vec4<Type> R;
+
+          simd::Transform4(&R.X, &M[0][0], &V.X);
+          return R;
+        }
+        else
+          return vec4<Type>((V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0] + V.W * M[3][0]),
+                            (V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1] + V.W * M[3][1]),
+                            (V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2] + V.W * M[3][2]),
+                            (V.X * M[0][3] + V.Y * M[1][3] + V.Z * M[2][3] + V.W * M[3][3]));
       } /* End of 'Transform4x4' function */
 
       /* Get Type-pointer to matrix function.
@@ -727,25 +833,7 @@ namespace mth
       {
         matr C;
 
-        __m256d row1 = _mm256_load_pd(&M1.M[0][0]);
-        __m256d row2 = _mm256_load_pd(&M1.M[1][0]);
-        __m256d row3 = _mm256_load_pd(&M1.M[2][0]);
-        __m256d row4 = _mm256_load_pd(&M1.M[3][0]);
-
-        for (INT i = 0; i < 4; ++i)
-        {
-          __m256d brod1 = _mm256_broadcast_sd(&M[i][0]);
-          __m256d brod2 = _mm256_broadcast_sd(&M[i][1]);
-          __m256d brod3 = _mm256_broadcast_sd(&M[i][2]);
-          __m256d brod4 = _mm256_broadcast_sd(&M[i][3]);
-          __m256d row = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(brod1, row1),
-                                                    _mm256_mul_pd(brod2, row2)),
-                                      _mm256_add_pd(_mm256_mul_pd(brod3, row3),
-                                                    _mm256_mul_pd(brod4, row4)));
-
-          _mm256_store_pd(&C.M[i][0], row);
-        }
-
+        simd::MatrMulMatr(&C.M[0][0], &M[0][0], &M1.M[0][0]);
         return C;
       } /* End of 'operator*' function */
 
@@ -756,26 +844,9 @@ namespace mth
        * RETURNS:
        *   (MATR) result matrix.
        */
-      __declspec(noinline) static VOID matrmulmatr( matr *MRes, matr *M1, matr *M2 )
+      MTH_NOINLINE static VOID matrmulmatr( matr *MRes, matr *M1, matr *M2 )
       {
-        __m256d row1 = _mm256_load_pd(&M2->M[0][0]);
-        __m256d row2 = _mm256_load_pd(&M2->M[1][0]);
-        __m256d row3 = _mm256_load_pd(&M2->M[2][0]);
-        __m256d row4 = _mm256_load_pd(&M2->M[3][0]);
-
-        for (INT i = 0; i < 4; ++i)
-        {
-          __m256d brod1 = _mm256_broadcast_sd(&M1->M[i][0]);
-          __m256d brod2 = _mm256_broadcast_sd(&M1->M[i][1]);
-          __m256d brod3 = _mm256_broadcast_sd(&M1->M[i][2]);
-          __m256d brod4 = _mm256_broadcast_sd(&M1->M[i][3]);
-          __m256d row   = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(brod1, row1),
-                                                      _mm256_mul_pd(brod2, row2)),
-                                        _mm256_add_pd(_mm256_mul_pd(brod3, row3),
-                                                      _mm256_mul_pd(brod4, row4)));
-
-          _mm256_store_pd(&MRes->M[i][0], row);
-        }
+        simd::MatrMulMatr(&MRes->M[0][0], &M1->M[0][0], &M2->M[0][0]);
       } /* End of 'operator*' function */
 
 
@@ -918,9 +989,10 @@ namespace mth
        */
       vec3<DBL> TransformPoint( const vec3<DBL> &V ) const
       {
-        return vec3<DBL>((V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0] + M[3][0]),
-                         (V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1] + M[3][1]),
-                         (V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2] + M[3][2]));
+        vec3<DBL> R;
+
+        simd::TransformPoint(&R.X, &M[0][0], &V.X);
+        return R;
       } /* End of 'TransformPoint' function */
 
       /* Transform vector by Matrix function.
@@ -932,9 +1004,10 @@ namespace mth
        */
       vec3<DBL> TransformVector( const vec3<DBL> &V ) const
       {
-        return vec3<DBL>(V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0],
-                         V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1],
-                         V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2]);
+        vec3<DBL> R;
+
+        simd::TransformVector(&R.X, &M[0][0], &V.X);
+        return R;
       } /* End of 'TransformVector' function */
 
       /* Transform vector by Matrix 4 * 3 function.
@@ -953,6 +1026,46 @@ namespace mth
                           V.X * m.M[0][2] + V.Y * m.M[1][2] + V.Z * m.M[2][2]);
       } /* End of 'TransformVector' function */
 
+      /* Transform points batch (structure of arrays) function.
+       * ARGUMENTS:
+       *   - points components arrays (transformed in place):
+       *       DBL *X, *Y, *Z;
+       *   - points count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      VOID TransformPoints( DBL *X, DBL *Y, DBL *Z, INT N ) const
+      {
+        simd::TransformBatch(X, Y, Z, N, &M[0][0], TRUE);
+      } /* End of 'TransformPoints' function */
+
+      /* Transform vectors batch (structure of arrays) function.
+       * ARGUMENTS:
+       *   - vectors components arrays (transformed in place):
+       *       DBL *X, *Y, *Z;
+       *   - vectors count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      VOID TransformVectors( DBL *X, DBL *Y, DBL *Z, INT N ) const
+      {
+        simd::TransformBatch(X, Y, Z, N, &M[0][0], FALSE);
+      } /* End of 'TransformVectors' function */
+
+      /* Transform normals batch (structure of arrays) function.
+       * ARGUMENTS:
+       *   - normals components arrays (transformed in place):
+       *       DBL *X, *Y, *Z;
+       *   - normals count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      VOID TransformNormals( DBL *X, DBL *Y, DBL *Z, INT N ) const
+      {
+        // Inverse transpose is evaluated once for all normals
+        this->Transpose().Inverse().TransformVectors(X, Y, Z, N);
+      } /* End of 'TransformNormals' function */
+
       /* Transform 4x4 vector function.
        * ARGUMENTS:
        *   - vector:
@@ -976,10 +1089,10 @@ namespace mth
        */
       vec4<DBL> Transform4x4( const vec4<DBL> &V ) const
       {
-        return vec4<DBL>((V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0] + V.W * M[3][0]),
-                          (V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1] + V.W * M[3][1]),
-                          (V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2] + V.W * M[3][2]),
-                          (V.X * M[0][3] + V.Y * M[1][3] + V.Z * M[2][3] + V.W * M[3][3]));
+        vec4<DBL> R;
+
+        simd::Transform4(&R.X, &M[0][0], &V.X);
+        return R;
       } /* End of 'Transform4x4' function */
 
       /* Get DBL-pointer to matrix function.
@@ -5,9 +5,11 @@
 
 /* FILE:        mth_ray.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 21.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math ray header file.
- * NOTE:        None.
+ * NOTE:        Ray differentials are derivatives of ray origin and
+ *              (normalized) direction by frame X and Y coordinates,
+ *              see Igehy, "Tracing ray differentials" (1999).
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -57,6 +59,68 @@ namespace mth
         return Org + Dir * T;
       } /* End of 'operator()' function */
     }; /* End of 'ray' class */
+
+  /* Ray differentials type */
+  template<typename Type>
+    class ray_diff
+    {
+    public:
+      vec3<Type>
+        dOdx, dOdy,  // Origin derivatives by frame X and Y
+        dDdx, dDdy;  // Direction derivatives by frame X and Y
+
+      /* Get scaled differentials (other frame step) function.
+       * ARGUMENTS:
+       *   - scale:
+       *       Type S;
+       * RETURNS:
+       *   (ray_diff) scaled differentials.
+       */
+      ray_diff Scaled( Type S ) const
+      {
+        return {dOdx * S, dOdy * S, dDdx * S, dDdy * S};
+      } /* End of 'Scaled' function */
+
+      /* Transfer differentials to ray hit point function.
+       * ARGUMENTS:
+       *   - ray (direction is normalized):
+       *       const ray<Type> &R;
+       *   - hit ray parameter:
+       *       Type T;
+       *   - hit surface normal:
+       *       const vec3<Type> &N;
+       *   - hit point derivatives to be set:
+       *       vec3<Type> *dPdx, *dPdy;
+       * RETURNS: None.
+       */
+      VOID Transfer( const ray<Type> &R, Type T, const vec3<Type> &N, vec3<Type> *dPdx, vec3<Type> *dPdy ) const
+      {
+        Type dn = R.Dir & N;
+
+        *dPdx = dOdx + dDdx * T;
+        *dPdy = dOdy + dDdy * T;
+        // Points stay on hit plane (tangent one)
+        if (dn > 1e-8 || dn < -1e-8)
+        {
+          *dPdx -= R.Dir * ((*dPdx & N) / dn);
+          *dPdy -= R.Dir * ((*dPdy & N) / dn);
+        }
+      } /* End of 'Transfer' function */
+
+      /* Get reflected ray differentials (flat surface) function.
+       * ARGUMENTS:
+       *   - surface normal (normalized):
+       *       const vec3<Type> &N;
+       *   - hit point derivatives (reflected ray origin ones):
+       *       const vec3<Type> &dPdx, &dPdy;
+       * RETURNS:
+       *   (ray_diff) reflected ray differentials.
+       */
+      ray_diff Reflect( const vec3<Type> &N, const vec3<Type> &dPdx, const vec3<Type> &dPdy ) const
+      {
+        return {dPdx, dPdy, dDdx - N * (2 * (dDdx & N)), dDdy - N * (2 * (dDdy & N))};
+      } /* End of 'Reflect' function */
+    }; /* End of 'ray_diff' class */
 } /* end of 'mth' namespace */
 
 #endif // !__mth_ray_h_
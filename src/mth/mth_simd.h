@@ -0,0 +1,858 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_simd.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     Base math SIMD kernels (double and single precision)
+ *              header file.
+ * NOTE:        Backend is selected at compile time: AVX (if
+ *              MTH_USE_AVX is defined), SSE2 (all x86-64 targets)
+ *              or scalar code (other targets or MTH_NO_SIMD defined).
+ *              SIMD kernels add products in the same order as
+ *              'scalar' namespace ones, so results are the same
+ *              (if compiler does not contract scalar code to FMA).
+ *              Destination may be the same as source vectors, but
+ *              not as matrices. Single precision kernels keep vector
+ *              or matrix row in one SSE register. Batch kernels
+ *              transform structure of arrays (separate X, Y, Z arrays)
+ *              by 4 (AVX) or 2 (SSE2) doubles and by 8 (AVX) or 4 (SSE2)
+ *              floats at once. Kernels which lose to scalar code (by
+ *              '-mthcheck' and renders time) are scalar ones.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_simd_h_
+#define __mth_simd_h_
+
+#include <cmath>
+#include <type_traits>
+
+#include "mth_def.h"
+
+/* SIMD backend selection flags */
+#if !defined(MTH_NO_SIMD) && defined(MTH_USE_AVX)
+#define MTH_SIMD_AVX
+#define MTH_SIMD_SSE2
+#elif !defined(MTH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MTH_SIMD_SSE2
+#endif // MTH_NO_SIMD
+
+/* Space math namespace */
+namespace mth
+{
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+    /* Scalar (reference) kernels namespace */
+    namespace scalar
+    {
+      /* 3D vectors dot product function.
+       * ARGUMENTS:
+       *   - vectors components:
+       *       const Type *A, *B;
+       * RETURNS:
+       *   (Type) dot product.
+       */
+      template<typename Type>
+        inline Type Dot3( const Type *A, const Type *B )
+        {
+          return A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
+        } /* End of 'Dot3' function */
+
+      /* 3D vectors cross product function.
+       * ARGUMENTS:
+       *   - result vector components:
+       *       Type *D;
+       *   - vectors components:
+       *       const Type *A, *B;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID Cross3( Type *D, const Type *A, const Type *B )
+        {
+          Type
+            x = A[1] * B[2] - A[2] * B[1],
+            y = A[2] * B[0] - A[0] * B[2],
+            z = A[0] * B[1] - A[1] * B[0];
+
+          D[0] = x;
+          D[1] = y;
+          D[2] = z;
+        } /* End of 'Cross3' function */
+
+      /* 3D vector divide by number function.
+       * ARGUMENTS:
+       *   - result vector components:
+       *       Type *D;
+       *   - vector components:
+       *       const Type *A;
+       *   - number:
+       *       Type N;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID Div3( Type *D, const Type *A, Type N )
+        {
+          D[0] = A[0] / N;
+          D[1] = A[1] / N;
+          D[2] = A[2] / N;
+        } /* End of 'Div3' function */
+
+      /* 4D vectors dot product function.
+       * ARGUMENTS:
+       *   - vectors components:
+       *       const Type *A, *B;
+       * RETURNS:
+       *   (Type) dot product.
+       */
+      template<typename Type>
+        inline Type Dot4( const Type *A, const Type *B )
+        {
+          return A[0] * B[0] + A[1] * B[1] + A[2] * B[2] + A[3] * B[3];
+        } /* End of 'Dot4' function */
+
+      /* 4x4 matrices multiplication function.
+       * ARGUMENTS:
+       *   - result matrix (row by row):
+       *       Type *D;
+       *   - matrices:
+       *       const Type *A, *B;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID MatrMulMatr( Type *D, const Type *A, const Type *B )
+        {
+          for (INT i = 0; i < 4; i++)
+            for (INT j = 0; j < 4; j++)
+              D[i * 4 + j] =
+                A[i * 4 + 0] * B[0 * 4 + j] + A[i * 4 + 1] * B[1 * 4 + j] +
+                A[i * 4 + 2] * B[2 * 4 + j] + A[i * 4 + 3] * B[3 * 4 + j];
+        } /* End of 'MatrMulMatr' function */
+
+      /* Point transformation (by row vector) function.
+       * ARGUMENTS:
+       *   - result point components:
+       *       Type *D;
+       *   - matrix:
+       *       const Type *M;
+       *   - point components:
+       *       const Type *V;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID TransformPoint( Type *D, const Type *M, const Type *V )
+        {
+          Type
+            x = V[0] * M[0] + V[1] * M[4] + V[2] * M[8] + M[12],
+            y = V[0] * M[1] + V[1] * M[5] + V[2] * M[9] + M[13],
+            z = V[0] * M[2] + V[1] * M[6] + V[2] * M[10] + M[14];
+
+          D[0] = x;
+          D[1] = y;
+          D[2] = z;
+        } /* End of 'TransformPoint' function */
+
+      /* Vector transformation (by row vector, without translation) function.
+       * ARGUMENTS:
+       *   - result vector components:
+       *       Type *D;
+       *   - matrix:
+       *       const Type *M;
+       *   - vector components:
+       *       const Type *V;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID TransformVector( Type *D, const Type *M, const Type *V )
+        {
+          Type
+            x = V[0] * M[0] + V[1] * M[4] + V[2] * M[8],
+            y = V[0] * M[1] + V[1] * M[5] + V[2] * M[9],
+            z = V[0] * M[2] + V[1] * M[6] + V[2] * M[10];
+
+          D[0] = x;
+          D[1] = y;
+          D[2] = z;
+        } /* End of 'TransformVector' function */
+
+      /* 4D vector transformation (by row vector) function.
+       * ARGUMENTS:
+       *   - result vector components:
+       *       Type *D;
+       *   - matrix:
+       *       const Type *M;
+       *   - vector components:
+       *       const Type *V;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID Transform4( Type *D, const Type *M, const Type *V )
+        {
+          Type R[4];
+
+          for (INT j = 0; j < 4; j++)
+            R[j] = V[0] * M[j] + V[1] * M[4 + j] + V[2] * M[8 + j] + V[3] * M[12 + j];
+          for (INT j = 0; j < 4; j++)
+            D[j] = R[j];
+        } /* End of 'Transform4' function */
+
+      /* Points or vectors batch (structure of arrays) transformation function.
+       * ARGUMENTS:
+       *   - components arrays (transformed in place):
+       *       Type *X, *Y, *Z;
+       *   - items count:
+       *       INT N;
+       *   - matrix:
+       *       const Type *M;
+       *   - points (with translation) flag:
+       *       BOOL IsPoint;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID TransformBatch( Type *X, Type *Y, Type *Z, INT N, const Type *M, BOOL IsPoint )
+        {
+          for (INT i = 0; i < N; i++)
+          {
+            Type V[3] = {X[i], Y[i], Z[i]};
+
+            if (IsPoint)
+              TransformPoint(V, M, V);
+            else
+              TransformVector(V, M, V);
+            X[i] = V[0];
+            Y[i] = V[1];
+            Z[i] = V[2];
+          }
+        } /* End of 'TransformBatch' function */
+
+      /* Vectors batch (structure of arrays) normalization function.
+       * ARGUMENTS:
+       *   - components arrays (normalized in place):
+       *       Type *X, *Y, *Z;
+       *   - items count:
+       *       INT N;
+       * RETURNS: None.
+       */
+      template<typename Type>
+        inline VOID NormalizeBatch( Type *X, Type *Y, Type *Z, INT N )
+        {
+          for (INT i = 0; i < N; i++)
+          {
+            Type V[3] = {X[i], Y[i], Z[i]};
+
+            Div3(V, V, std::sqrt(Dot3(V, V)));
+            X[i] = V[0];
+            Y[i] = V[1];
+            Z[i] = V[2];
+          }
+        } /* End of 'NormalizeBatch' function */
+    } /* end of 'scalar' namespace */
+
+    /* Kernels component type flag (double and float kernels are provided) */
+    template<typename Type>
+      inline constexpr bool IsKernelType = std::is_same_v<Type, DBL> || std::is_same_v<Type, FLT>;
+
+    /* Get backend name function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const CHAR *) backend name.
+     */
+    inline const CHAR * Backend( VOID )
+    {
+#if defined(MTH_SIMD_AVX)
+      return "AVX";
+#elif defined(MTH_SIMD_SSE2)
+      return "SSE2";
+#else // MTH_SIMD_AVX
+      return "scalar";
+#endif // MTH_SIMD_AVX
+    } /* End of 'Backend' function */
+
+#ifdef MTH_SIMD_SSE2
+#ifdef MTH_SIMD_AVX
+    /* 3D vectors dot product function.
+     * ARGUMENTS:
+     *   - vectors components:
+     *       const DBL *A, *B;
+     * RETURNS:
+     *   (DBL) dot product.
+     */
+    inline DBL Dot3( const DBL *A, const DBL *B )
+    {
+      __m128d
+        p = _mm_mul_pd(_mm_loadu_pd(A), _mm_loadu_pd(B)),
+        s = _mm_add_sd(p, _mm_unpackhi_pd(p, p));
+
+      return _mm_cvtsd_f64(_mm_add_sd(s, _mm_mul_sd(_mm_load_sd(A + 2), _mm_load_sd(B + 2))));
+    } /* End of 'Dot3' function */
+#else // MTH_SIMD_AVX
+    // SSE2 dot product loses to compiler scheduled scalar code
+    using scalar::Dot3;
+#endif // MTH_SIMD_AVX
+    // Double cross product shuffles lose to scalar code (both on SSE2 and AVX)
+    using scalar::Cross3;
+    // Two divisions by SIMD are not faster than three scalar ones
+    using scalar::Div3;
+
+    /* 4D vectors dot product function.
+     * ARGUMENTS:
+     *   - vectors components:
+     *       const DBL *A, *B;
+     * RETURNS:
+     *   (DBL) dot product.
+     */
+    inline DBL Dot4( const DBL *A, const DBL *B )
+    {
+      __m128d
+        p01 = _mm_mul_pd(_mm_loadu_pd(A), _mm_loadu_pd(B)),
+        p23 = _mm_mul_pd(_mm_loadu_pd(A + 2), _mm_loadu_pd(B + 2)),
+        s = _mm_add_sd(_mm_add_sd(p01, _mm_unpackhi_pd(p01, p01)), p23);
+
+      return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(p23, p23)));
+    } /* End of 'Dot4' function */
+
+    /* 4x4 matrices multiplication function.
+     * ARGUMENTS:
+     *   - result matrix (row by row):
+     *       DBL *D;
+     *   - matrices:
+     *       const DBL *A, *B;
+     * RETURNS: None.
+     */
+    inline VOID MatrMulMatr( DBL *D, const DBL *A, const DBL *B )
+    {
+#ifdef MTH_SIMD_AVX
+      __m256d
+        r0 = _mm256_loadu_pd(B), r1 = _mm256_loadu_pd(B + 4),
+        r2 = _mm256_loadu_pd(B + 8), r3 = _mm256_loadu_pd(B + 12);
+
+      for (INT i = 0; i < 4; i++)
+      {
+        const DBL *a = A + i * 4;
+        __m256d
+          s = _mm256_add_pd(_mm256_mul_pd(_mm256_broadcast_sd(a), r0), _mm256_mul_pd(_mm256_broadcast_sd(a + 1), r1));
+
+        s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_broadcast_sd(a + 2), r2));
+        _mm256_storeu_pd(D + i * 4, _mm256_add_pd(s, _mm256_mul_pd(_mm256_broadcast_sd(a + 3), r3)));
+      }
+#else // MTH_SIMD_AVX
+      // SSE2 half rows (with broadcasts for every half) lose to scalar code
+      scalar::MatrMulMatr(D, A, B);
+#endif // MTH_SIMD_AVX
+    } /* End of 'MatrMulMatr' function */
+
+    /* Point or vector transformation (by row vector) function.
+     * ARGUMENTS:
+     *   - result components (3 or 4 are stored):
+     *       DBL *D;
+     *   - matrix:
+     *       const DBL *M;
+     *   - vector components:
+     *       const DBL *V;
+     *   - fourth component usage (0 - none, 1 - translation, 2 - V[3] coordinate):
+     *       INT Mode;
+     * RETURNS: None.
+     */
+    inline VOID TransformRows( DBL *D, const DBL *M, const DBL *V, INT Mode )
+    {
+#ifdef MTH_SIMD_AVX
+      __m256d
+        s = _mm256_add_pd(_mm256_mul_pd(_mm256_broadcast_sd(V), _mm256_loadu_pd(M)),
+                          _mm256_mul_pd(_mm256_broadcast_sd(V + 1), _mm256_loadu_pd(M + 4)));
+
+      s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_broadcast_sd(V + 2), _mm256_loadu_pd(M + 8)));
+      if (Mode == 1)
+        s = _mm256_add_pd(s, _mm256_loadu_pd(M + 12));
+      else if (Mode == 2)
+        s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_broadcast_sd(V + 3), _mm256_loadu_pd(M + 12)));
+      if (Mode == 2)
+        _mm256_storeu_pd(D, s);
+      else
+      {
+        _mm_storeu_pd(D, _mm256_castpd256_pd128(s));
+        _mm_store_sd(D + 2, _mm256_extractf128_pd(s, 1));
+      }
+#else // MTH_SIMD_AVX
+      __m128d
+        x = _mm_set1_pd(V[0]), y = _mm_set1_pd(V[1]), z = _mm_set1_pd(V[2]),
+        s01 = _mm_add_pd(_mm_mul_pd(x, _mm_loadu_pd(M)), _mm_mul_pd(y, _mm_loadu_pd(M + 4))),
+        s23 = _mm_add_pd(_mm_mul_pd(x, _mm_loadu_pd(M + 2)), _mm_mul_pd(y, _mm_loadu_pd(M + 6)));
+
+      s01 = _mm_add_pd(s01, _mm_mul_pd(z, _mm_loadu_pd(M + 8)));
+      s23 = _mm_add_pd(s23, _mm_mul_pd(z, _mm_loadu_pd(M + 10)));
+      if (Mode == 1)
+      {
+        s01 = _mm_add_pd(s01, _mm_loadu_pd(M + 12));
+        s23 = _mm_add_pd(s23, _mm_loadu_pd(M + 14));
+      }
+      else if (Mode == 2)
+      {
+        __m128d w = _mm_set1_pd(V[3]);
+
+        s01 = _mm_add_pd(s01, _mm_mul_pd(w, _mm_loadu_pd(M + 12)));
+        s23 = _mm_add_pd(s23, _mm_mul_pd(w, _mm_loadu_pd(M + 14)));
+      }
+      _mm_storeu_pd(D, s01);
+      if (Mode == 2)
+        _mm_storeu_pd(D + 2, s23);
+      else
+        _mm_store_sd(D + 2, s23);
+#endif // MTH_SIMD_AVX
+    } /* End of 'TransformRows' function */
+
+    /* Point transformation (by row vector) function.
+     * ARGUMENTS:
+     *   - result point components:
+     *       DBL *D;
+     *   - matrix:
+     *       const DBL *M;
+     *   - point components:
+     *       const DBL *V;
+     * RETURNS: None.
+     */
+    inline VOID TransformPoint( DBL *D, const DBL *M, const DBL *V )
+    {
+#ifdef MTH_SIMD_AVX
+      TransformRows(D, M, V, 1);
+#else // MTH_SIMD_AVX
+      // SSE2 translation (two more additions) loses to scalar code
+      scalar::TransformPoint(D, M, V);
+#endif // MTH_SIMD_AVX
+    } /* End of 'TransformPoint' function */
+
+    /* Vector transformation (by row vector, without translation) function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       DBL *D;
+     *   - matrix:
+     *       const DBL *M;
+     *   - vector components:
+     *       const DBL *V;
+     * RETURNS: None.
+     */
+    inline VOID TransformVector( DBL *D, const DBL *M, const DBL *V )
+    {
+      TransformRows(D, M, V, 0);
+    } /* End of 'TransformVector' function */
+
+    /* 4D vector transformation (by row vector) function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       DBL *D;
+     *   - matrix:
+     *       const DBL *M;
+     *   - vector components:
+     *       const DBL *V;
+     * RETURNS: None.
+     */
+    inline VOID Transform4( DBL *D, const DBL *M, const DBL *V )
+    {
+      TransformRows(D, M, V, 2);
+    } /* End of 'Transform4' function */
+
+    /* Points or vectors batch (structure of arrays) transformation function.
+     * ARGUMENTS:
+     *   - components arrays (transformed in place):
+     *       DBL *X, *Y, *Z;
+     *   - items count:
+     *       INT N;
+     *   - matrix:
+     *       const DBL *M;
+     *   - points (with translation) flag:
+     *       BOOL IsPoint;
+     * RETURNS: None.
+     */
+    inline VOID TransformBatch( DBL *X, DBL *Y, DBL *Z, INT N, const DBL *M, BOOL IsPoint )
+    {
+      INT i = 0;
+
+#ifdef MTH_SIMD_AVX
+      __m256d M4[12];
+
+      for (INT k = 0; k < 12; k++)
+        M4[k] = _mm256_broadcast_sd(M + (k / 3) * 4 + k % 3);
+      for (; i + 4 <= N; i += 4)
+      {
+        __m256d
+          x = _mm256_loadu_pd(X + i), y = _mm256_loadu_pd(Y + i), z = _mm256_loadu_pd(Z + i),
+          rx = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, M4[0]), _mm256_mul_pd(y, M4[3])), _mm256_mul_pd(z, M4[6])),
+          ry = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, M4[1]), _mm256_mul_pd(y, M4[4])), _mm256_mul_pd(z, M4[7])),
+          rz = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, M4[2]), _mm256_mul_pd(y, M4[5])), _mm256_mul_pd(z, M4[8]));
+
+        if (IsPoint)
+        {
+          rx = _mm256_add_pd(rx, M4[9]);
+          ry = _mm256_add_pd(ry, M4[10]);
+          rz = _mm256_add_pd(rz, M4[11]);
+        }
+        _mm256_storeu_pd(X + i, rx);
+        _mm256_storeu_pd(Y + i, ry);
+        _mm256_storeu_pd(Z + i, rz);
+      }
+#endif // MTH_SIMD_AVX
+      __m128d M2[12];
+
+      for (INT k = 0; k < 12; k++)
+        M2[k] = _mm_set1_pd(M[(k / 3) * 4 + k % 3]);
+      for (; i + 2 <= N; i += 2)
+      {
+        __m128d
+          x = _mm_loadu_pd(X + i), y = _mm_loadu_pd(Y + i), z = _mm_loadu_pd(Z + i),
+          rx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, M2[0]), _mm_mul_pd(y, M2[3])), _mm_mul_pd(z, M2[6])),
+          ry = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, M2[1]), _mm_mul_pd(y, M2[4])), _mm_mul_pd(z, M2[7])),
+          rz = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, M2[2]), _mm_mul_pd(y, M2[5])), _mm_mul_pd(z, M2[8]));
+
+        if (IsPoint)
+        {
+          rx = _mm_add_pd(rx, M2[9]);
+          ry = _mm_add_pd(ry, M2[10]);
+          rz = _mm_add_pd(rz, M2[11]);
+        }
+        _mm_storeu_pd(X + i, rx);
+        _mm_storeu_pd(Y + i, ry);
+        _mm_storeu_pd(Z + i, rz);
+      }
+      scalar::TransformBatch(X + i, Y + i, Z + i, N - i, M, IsPoint);
+    } /* End of 'TransformBatch' function */
+
+    /* Vectors batch (structure of arrays) normalization function.
+     * ARGUMENTS:
+     *   - components arrays (normalized in place):
+     *       DBL *X, *Y, *Z;
+     *   - items count:
+     *       INT N;
+     * RETURNS: None.
+     */
+    inline VOID NormalizeBatch( DBL *X, DBL *Y, DBL *Z, INT N )
+    {
+      INT i = 0;
+
+#ifdef MTH_SIMD_AVX
+      for (; i + 4 <= N; i += 4)
+      {
+        __m256d
+          x = _mm256_loadu_pd(X + i), y = _mm256_loadu_pd(Y + i), z = _mm256_loadu_pd(Z + i),
+          l = _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)),
+                                           _mm256_mul_pd(z, z)));
+
+        _mm256_storeu_pd(X + i, _mm256_div_pd(x, l));
+        _mm256_storeu_pd(Y + i, _mm256_div_pd(y, l));
+        _mm256_storeu_pd(Z + i, _mm256_div_pd(z, l));
+      }
+#endif // MTH_SIMD_AVX
+      for (; i + 2 <= N; i += 2)
+      {
+        __m128d
+          x = _mm_loadu_pd(X + i), y = _mm_loadu_pd(Y + i), z = _mm_loadu_pd(Z + i),
+          l = _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)), _mm_mul_pd(z, z)));
+
+        _mm_storeu_pd(X + i, _mm_div_pd(x, l));
+        _mm_storeu_pd(Y + i, _mm_div_pd(y, l));
+        _mm_storeu_pd(Z + i, _mm_div_pd(z, l));
+      }
+      scalar::NormalizeBatch(X + i, Y + i, Z + i, N - i);
+    } /* End of 'NormalizeBatch' function */
+
+    /* Load 3D vector (fourth component is zero) function.
+     * ARGUMENTS:
+     *   - vector components:
+     *       const FLT *A;
+     * RETURNS:
+     *   (__m128) vector register.
+     */
+    inline __m128 Load3( const FLT *A )
+    {
+      // Components are loaded separately, so just stored ones are forwarded (one wide load waits for stores)
+      return _mm_setr_ps(A[0], A[1], A[2], 0);
+    } /* End of 'Load3' function */
+
+    /* Store 3D vector function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       FLT *D;
+     *   - vector register:
+     *       __m128 V;
+     * RETURNS: None.
+     */
+    inline VOID Store3( FLT *D, __m128 V )
+    {
+      _mm_storel_pi((__m64 *)D, V);
+      _mm_store_ss(D + 2, _mm_movehl_ps(V, V));
+    } /* End of 'Store3' function */
+
+    // Float dot product latency (two horizontal additions) loses to scalar one in renders
+    using scalar::Dot3;
+
+    /* 3D vectors cross product function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       FLT *D;
+     *   - vectors components:
+     *       const FLT *A, *B;
+     * RETURNS: None.
+     */
+    inline VOID Cross3( FLT *D, const FLT *A, const FLT *B )
+    {
+      __m128
+        a = Load3(A), b = Load3(B),
+        a120 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), b120 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1)),
+        d201 = _mm_sub_ps(_mm_mul_ps(a, b120), _mm_mul_ps(a120, b));
+
+      // Components are evaluated in (z, x, y) order, so one more shuffle is needed
+      Store3(D, _mm_shuffle_ps(d201, d201, _MM_SHUFFLE(3, 0, 2, 1)));
+    } /* End of 'Cross3' function */
+
+    /* 3D vector divide by number function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       FLT *D;
+     *   - vector components:
+     *       const FLT *A;
+     *   - number:
+     *       FLT N;
+     * RETURNS: None.
+     */
+    inline VOID Div3( FLT *D, const FLT *A, FLT N )
+    {
+      Store3(D, _mm_div_ps(Load3(A), _mm_set1_ps(N)));
+    } /* End of 'Div3' function */
+
+    /* 4D vectors dot product function.
+     * ARGUMENTS:
+     *   - vectors components:
+     *       const FLT *A, *B;
+     * RETURNS:
+     *   (FLT) dot product.
+     */
+    inline FLT Dot4( const FLT *A, const FLT *B )
+    {
+      __m128
+        p = _mm_mul_ps(_mm_loadu_ps(A), _mm_loadu_ps(B)),
+        s = _mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, 1)), _mm_movehl_ps(p, p));
+
+      return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(p, p, 3)));
+    } /* End of 'Dot4' function */
+
+    /* 4x4 matrices multiplication function.
+     * ARGUMENTS:
+     *   - result matrix (row by row):
+     *       FLT *D;
+     *   - matrices:
+     *       const FLT *A, *B;
+     * RETURNS: None.
+     */
+    inline VOID MatrMulMatr( FLT *D, const FLT *A, const FLT *B )
+    {
+      __m128
+        r0 = _mm_loadu_ps(B), r1 = _mm_loadu_ps(B + 4),
+        r2 = _mm_loadu_ps(B + 8), r3 = _mm_loadu_ps(B + 12);
+
+      for (INT i = 0; i < 4; i++)
+      {
+        const FLT *a = A + i * 4;
+        __m128
+          s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), r0), _mm_mul_ps(_mm_set1_ps(a[1]), r1));
+
+        s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(a[2]), r2));
+        _mm_storeu_ps(D + i * 4, _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(a[3]), r3)));
+      }
+    } /* End of 'MatrMulMatr' function */
+
+    /* Point or vector transformation (by row vector) function.
+     * ARGUMENTS:
+     *   - result components (3 or 4 are stored):
+     *       FLT *D;
+     *   - matrix:
+     *       const FLT *M;
+     *   - vector components:
+     *       const FLT *V;
+     *   - fourth component usage (0 - none, 1 - translation, 2 - V[3] coordinate):
+     *       INT Mode;
+     * RETURNS: None.
+     */
+    inline VOID TransformRows( FLT *D, const FLT *M, const FLT *V, INT Mode )
+    {
+      __m128
+        s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(V[0]), _mm_loadu_ps(M)), _mm_mul_ps(_mm_set1_ps(V[1]), _mm_loadu_ps(M + 4)));
+
+      s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(V[2]), _mm_loadu_ps(M + 8)));
+      if (Mode == 1)
+        s = _mm_add_ps(s, _mm_loadu_ps(M + 12));
+      else if (Mode == 2)
+        s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(V[3]), _mm_loadu_ps(M + 12)));
+      if (Mode == 2)
+        _mm_storeu_ps(D, s);
+      else
+        Store3(D, s);
+    } /* End of 'TransformRows' function */
+
+    /* Point transformation (by row vector) function.
+     * ARGUMENTS:
+     *   - result point components:
+     *       FLT *D;
+     *   - matrix:
+     *       const FLT *M;
+     *   - point components:
+     *       const FLT *V;
+     * RETURNS: None.
+     */
+    inline VOID TransformPoint( FLT *D, const FLT *M, const FLT *V )
+    {
+      TransformRows(D, M, V, 1);
+    } /* End of 'TransformPoint' function */
+
+    /* Vector transformation (by row vector, without translation) function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       FLT *D;
+     *   - matrix:
+     *       const FLT *M;
+     *   - vector components:
+     *       const FLT *V;
+     * RETURNS: None.
+     */
+    inline VOID TransformVector( FLT *D, const FLT *M, const FLT *V )
+    {
+      TransformRows(D, M, V, 0);
+    } /* End of 'TransformVector' function */
+
+    /* 4D vector transformation (by row vector) function.
+     * ARGUMENTS:
+     *   - result vector components:
+     *       FLT *D;
+     *   - matrix:
+     *       const FLT *M;
+     *   - vector components:
+     *       const FLT *V;
+     * RETURNS: None.
+     */
+    inline VOID Transform4( FLT *D, const FLT *M, const FLT *V )
+    {
+      TransformRows(D, M, V, 2);
+    } /* End of 'Transform4' function */
+
+    /* Points or vectors batch (structure of arrays) transformation function.
+     * ARGUMENTS:
+     *   - components arrays (transformed in place):
+     *       FLT *X, *Y, *Z;
+     *   - items count:
+     *       INT N;
+     *   - matrix:
+     *       const FLT *M;
+     *   - points (with translation) flag:
+     *       BOOL IsPoint;
+     * RETURNS: None.
+     */
+    inline VOID TransformBatch( FLT *X, FLT *Y, FLT *Z, INT N, const FLT *M, BOOL IsPoint )
+    {
+      INT i = 0;
+
+#ifdef MTH_SIMD_AVX
+      __m256 M8[12];
+
+      for (INT k = 0; k < 12; k++)
+        M8[k] = _mm256_broadcast_ss(M + (k / 3) * 4 + k % 3);
+      for (; i + 8 <= N; i += 8)
+      {
+        __m256
+          x = _mm256_loadu_ps(X + i), y = _mm256_loadu_ps(Y + i), z = _mm256_loadu_ps(Z + i),
+          rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, M8[0]), _mm256_mul_ps(y, M8[3])), _mm256_mul_ps(z, M8[6])),
+          ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, M8[1]), _mm256_mul_ps(y, M8[4])), _mm256_mul_ps(z, M8[7])),
+          rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, M8[2]), _mm256_mul_ps(y, M8[5])), _mm256_mul_ps(z, M8[8]));
+
+        if (IsPoint)
+        {
+          rx = _mm256_add_ps(rx, M8[9]);
+          ry = _mm256_add_ps(ry, M8[10]);
+          rz = _mm256_add_ps(rz, M8[11]);
+        }
+        _mm256_storeu_ps(X + i, rx);
+        _mm256_storeu_ps(Y + i, ry);
+        _mm256_storeu_ps(Z + i, rz);
+      }
+#endif // MTH_SIMD_AVX
+      __m128 M4[12];
+
+      for (INT k = 0; k < 12; k++)
+        M4[k] = _mm_set1_ps(M[(k / 3) * 4 + k % 3]);
+      for (; i + 4 <= N; i += 4)
+      {
+        __m128
+          x = _mm_loadu_ps(X + i), y = _mm_loadu_ps(Y + i), z = _mm_loadu_ps(Z + i),
+          rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, M4[0]), _mm_mul_ps(y, M4[3])), _mm_mul_ps(z, M4[6])),
+          ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, M4[1]), _mm_mul_ps(y, M4[4])), _mm_mul_ps(z, M4[7])),
+          rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, M4[2]), _mm_mul_ps(y, M4[5])), _mm_mul_ps(z, M4[8]));
+
+        if (IsPoint)
+        {
+          rx = _mm_add_ps(rx, M4[9]);
+          ry = _mm_add_ps(ry, M4[10]);
+          rz = _mm_add_ps(rz, M4[11]);
+        }
+        _mm_storeu_ps(X + i, rx);
+        _mm_storeu_ps(Y + i, ry);
+        _mm_storeu_ps(Z + i, rz);
+      }
+      scalar::TransformBatch(X + i, Y + i, Z + i, N - i, M, IsPoint);
+    } /* End of 'TransformBatch' function */
+
+    /* Vectors batch (structure of arrays) normalization function.
+     * ARGUMENTS:
+     *   - components arrays (normalized in place):
+     *       FLT *X, *Y, *Z;
+     *   - items count:
+     *       INT N;
+     * RETURNS: None.
+     */
+    inline VOID NormalizeBatch( FLT *X, FLT *Y, FLT *Z, INT N )
+    {
+      INT i = 0;
+
+#ifdef MTH_SIMD_AVX
+      for (; i + 8 <= N; i += 8)
+      {
+        __m256
+          x = _mm256_loadu_ps(X + i), y = _mm256_loadu_ps(Y + i), z = _mm256_loadu_ps(Z + i),
+          l = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+                                           _mm256_mul_ps(z, z)));
+
+        _mm256_storeu_ps(X + i, _mm256_div_ps(x, l));
+        _mm256_storeu_ps(Y + i, _mm256_div_ps(y, l));
+        _mm256_storeu_ps(Z + i, _mm256_div_ps(z, l));
+      }
+#endif // MTH_SIMD_AVX
+      for (; i + 4 <= N; i += 4)
+      {
+        __m128
+          x = _mm_loadu_ps(X + i), y = _mm_loadu_ps(Y + i), z = _mm_loadu_ps(Z + i),
+          l = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+
+        _mm_storeu_ps(X + i, _mm_div_ps(x, l));
+        _mm_storeu_ps(Y + i, _mm_div_ps(y, l));
+        _mm_storeu_ps(Z + i, _mm_div_ps(z, l));
+      }
+      scalar::NormalizeBatch(X + i, Y + i, Z + i, N - i);
+    } /* End of 'NormalizeBatch' function */
+#else // MTH_SIMD_SSE2
+    using scalar::Dot3;
+    using scalar::Cross3;
+    using scalar::Div3;
+    using scalar::Dot4;
+    using scalar::MatrMulMatr;
+    using scalar::TransformPoint;
+    using scalar::TransformVector;
+    using scalar::Transform4;
+    using scalar::TransformBatch;
+    using scalar::NormalizeBatch;
+#endif // MTH_SIMD_SSE2
+  } /* end of 'simd' namespace */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_simd_h_
+
+/* END OF 'mth_simd.h' FILE */
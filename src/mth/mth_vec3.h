@@ -5,9 +5,10 @@
 
 /* FILE:        mth_vec3.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 22.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math vector 3D header file.
- * NOTE:        None.
+ * NOTE:        Double and float vectors dot and cross products and
+ *              normalization use SIMD kernels (see 'mth_simd.h').
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -16,7 +17,7 @@
 #ifndef __mth_vec3_h_
 #define __mth_vec3_h_
 
-#include "mth_def.h"
+#include "mth_simd.h"
 
 /* Space math namespace */
 namespace mth
@@ -131,7 +132,10 @@ namespace mth
        */
       Type Len2() const
       {
-        return X * X + Y * Y + Z * Z;
+        if constexpr (simd::IsKernelType<Type>)
+          return simd::Dot3(&X, &X);
+        else
+          return X * X + Y * Y + Z * Z;
       } /* End of 'Len2' function */
 
       /* Vec length function.
@@ -153,7 +157,10 @@ namespace mth
        */
       Type operator&( const vec3 &V ) const
       {
-        return X * V.X + Y * V.Y + Z * V.Z;
+        if constexpr (simd::IsKernelType<Type>)
+          return simd::Dot3(&X, &V.X);
+        else
+          return X * V.X + Y * V.Y + Z * V.Z;
       } /* End of 'operator&' function */
 
       /* Vec cross vec function.
@@ -165,9 +172,17 @@ namespace mth
        */
       vec3 operator%( const vec3 &V ) const
       {
-        return vec3(Y * V.Z - Z * V.Y,
-                    Z * V.X - X * V.Z,
-                    X * V.Y - Y * V.X);
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          vec3 R;
+
+          simd::Cross3(&R.X, &X, &V.X);
+          return R;
+        }
+        else
+          return vec3(Y * V.Z - Z * V.Y,
+                      Z * V.X - X * V.Z,
+                      X * V.Y - Y * V.X);
       } /* End of 'operator%' function */
 
       /* Vec mul num function.
@@ -296,7 +311,13 @@ namespace mth
           return *this;
 #endif // _DEBUG
 
-        return *this /= std::sqrt(len2);
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          simd::Div3(&X, &X, std::sqrt(len2));
+          return *this;
+        }
+        else
+          return *this /= std::sqrt(len2);
       } /* End of 'Normalize' function */
 
       /* Get normalize vector.
@@ -313,7 +334,15 @@ namespace mth
           return *this;
 #endif // _DEBUG
 
-        return *this / std::sqrt(len2);
+        if constexpr (simd::IsKernelType<Type>)
+        {
+          vec3 R;
+
+          simd::Div3(&R.X, &X, std::sqrt(len2));
+          return R;
+        }
+        else
+          return *this / std::sqrt(len2);
       } /* End of 'Normalize' function */
 
       /* Get Type-pointer to vector function.
@@ -5,7 +5,7 @@
 
 /* FILE:        mth_vec4.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 22.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     Base math vector 4D header file.
  * NOTE:        None.
  * 
@@ -16,7 +16,7 @@
 #ifndef __mth_vec4_h_
 #define __mth_vec4_h_
 
-#include "mth_def.h"
+#include "mth_simd.h"
 
 /* Space math namespace */
 namespace mth
@@ -155,7 +155,10 @@ namespace mth
        */
       Type operator&( const vec4 &V ) const
       {
-        return X * V.X + Y * V.Y + Z * V.Z + W * V.W;
+        if constexpr (simd::IsKernelType<Type>)
+          return simd::Dot4(&X, &V.X);
+        else
+          return X * V.X + Y * V.Y + Z * V.Z + W * V.W;
       } /* End of 'operator&' function */
 
       /* Vec mul num function.
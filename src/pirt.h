@@ -17,7 +17,9 @@
 #define __pirt_h_
 
 #include "def.h"
+#ifdef _WIN32
 #include "win/win.h"
+#endif // _WIN32
 #include "rt/rt.h"
 #include "mem/memtools.h"
 
@@ -0,0 +1,63 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        port_def.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     Portable (non Win32) base types header file.
+ * NOTE:        Replaces <commondf.h> and <windows.h> types
+ *              on platforms without Win32 SDK.
+ * 
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __port_def_h_
+#define __port_def_h_
+
+#include <cstdint>
+#include <cstddef>
+
+/* Base void type */
+#ifndef VOID
+#  define VOID void
+#endif /* VOID */
+
+/* Integer data types */
+typedef char CHAR;
+typedef unsigned char BYTE;
+typedef short SHORT;
+typedef unsigned short USHORT;
+typedef unsigned short WORD;
+typedef uint32_t DWORD;
+typedef int INT;
+typedef unsigned int UINT;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef intptr_t INT_PTR;
+typedef uintptr_t UINT_PTR;
+
+/* Boolean data type */
+typedef int BOOL;
+#ifndef TRUE
+#  define TRUE 1
+#endif /* TRUE */
+#ifndef FALSE
+#  define FALSE 0
+#endif /* FALSE */
+
+/* Make DWORD value from 4 bytes (0 - low, 3 - high) macro */
+#define COM_MAKELONG0123(A0, A1, A2, A3) \
+  ((DWORD)(BYTE)(A0) |                   \
+   ((DWORD)(BYTE)(A1) << 8) |            \
+   ((DWORD)(BYTE)(A2) << 16) |           \
+   ((DWORD)(BYTE)(A3) << 24))
+
+/* Sign of number (-1, 0, 1) macro */
+#define COM_SIGN(X) ((X) < 0 ? -1 : (X) > 0 ? 1 : 0)
+
+#endif // !__port_def_h_
+
+/* END OF 'port_def.h' FILE */
@@ -0,0 +1,74 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        port_tga.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     Portable TGA file format structures header file.
+ * NOTE:        Replaces <tgahead.h> on platforms without TGRKIT.
+ *              Must be included inside '#pragma pack(1)' block.
+ * 
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __port_tga_h_
+#define __port_tga_h_
+
+#include "port_def.h"
+
+/* TGA 2.0 footer signature */
+#define TGA_EXT_SIGNATURE "TRUEVISION-XFILE."
+
+/* TGA file header structure */
+typedef struct tagtgaFILEHEADER
+{
+  BYTE IDLength;          /* Image identification field size in bytes */
+  BYTE ColorMapType;      /* 1 - image with palette */
+  BYTE ImageType;         /* Image type: 2 - true color, 3 - grayscale */
+  WORD PaletteStart;      /* Palette start index */
+  WORD PaletteSize;       /* Palette entries count */
+  BYTE PaletteEntrySize;  /* Palette entry size in bits */
+  WORD X, Y;              /* Image start coordinates */
+  WORD Width, Height;     /* Image size */
+  BYTE BitsPerPixel;      /* Bits per pixel */
+  BYTE ImageDescr;        /* Image descriptor: alpha bits, start corner */
+} tgaFILEHEADER;
+
+/* TGA 2.0 extension area structure */
+typedef struct tagtgaEXTHEADER
+{
+  WORD ExtensionSize;          /* Extension area size (495 bytes) */
+  CHAR AuthorName[41];         /* Author name */
+  CHAR AuthorComment[324];     /* Author comment */
+  WORD StampMonth, StampDay, StampYear,
+       StampHour, StampMinute, StampSecond; /* Date/time stamp */
+  CHAR JobName[41];            /* Job name */
+  WORD JobHour, JobMinute, JobSecond; /* Job time */
+  CHAR SoftwareID[41];         /* Software identifier */
+  WORD VersionNumber;          /* Software version (x100) */
+  BYTE VersionLetter;          /* Software version letter */
+  DWORD KeyColor;              /* Background key color */
+  WORD PixelNumerator,
+       PixelDenominator;       /* Pixel aspect ratio */
+  WORD GammaNumerator,
+       GammaDenominator;       /* Gamma value */
+  DWORD ColorCorrectionOffset; /* Color correction table offset */
+  DWORD PostageStampOffset;    /* Postage stamp image offset */
+  DWORD ScanLineOffset;        /* Scan line table offset */
+  BYTE AttributesType;         /* Alpha channel type */
+} tgaEXTHEADER;
+
+/* TGA 2.0 file footer structure */
+typedef struct tagtgaFILEFOOTER
+{
+  DWORD ExtensionOffset;  /* Extension area offset */
+  DWORD DeveloperOffset;  /* Developer directory offset */
+  CHAR Signature[18];     /* Signature "TRUEVISION-XFILE.\0" */
+} tgaFILEFOOTER;
+
+#endif // !__port_tga_h_
+
+/* END OF 'port_tga.h' FILE */
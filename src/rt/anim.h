@@ -0,0 +1,243 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        anim.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's camera and shapes keyframe animation header file.
+ * NOTE:        Keys are linearly interpolated by time. Shape key
+ *              transformation (scale, rotations by X, Y, Z, translation)
+ *              is applied after shape own (base) transformation.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __anim_h_
+#define __anim_h_
+
+#include <vector>
+#include <algorithm>
+
+#include "rt_def.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Camera key class */
+    class camera_key
+    {
+    public:
+      REAL Time;                    // Key time
+      vec3 Loc, At, Up;             // Camera location, look-at point and approximate up direction
+
+      /* Interpolate keys function.
+       * ARGUMENTS:
+       *   - keys to interpolate between:
+       *       const camera_key &A, &B;
+       *   - interpolation parameter [0..1]:
+       *       REAL t;
+       * RETURNS:
+       *   (camera_key) interpolated key.
+       */
+      static camera_key Lerp( const camera_key &A, const camera_key &B, REAL t )
+      {
+        return {A.Time + (B.Time - A.Time) * t,
+                A.Loc + (B.Loc - A.Loc) * t,
+                A.At + (B.At - A.At) * t,
+                A.Up + (B.Up - A.Up) * t};
+      } /* End of 'Lerp' function */
+    }; /* End of 'camera_key' class */
+
+    /* Shape transformation key class */
+    class transform_key
+    {
+    public:
+      REAL Time;                    // Key time
+      vec3 Pos;                     // Translation
+      vec3 Angles;                  // Rotation angles (in degrees) by X, Y, Z axes
+      vec3 Scale;                   // Scale
+
+      /* Interpolate keys function.
+       * ARGUMENTS:
+       *   - keys to interpolate between:
+       *       const transform_key &A, &B;
+       *   - interpolation parameter [0..1]:
+       *       REAL t;
+       * RETURNS:
+       *   (transform_key) interpolated key.
+       */
+      static transform_key Lerp( const transform_key &A, const transform_key &B, REAL t )
+      {
+        return {A.Time + (B.Time - A.Time) * t,
+                A.Pos + (B.Pos - A.Pos) * t,
+                A.Angles + (B.Angles - A.Angles) * t,
+                A.Scale + (B.Scale - A.Scale) * t};
+      } /* End of 'Lerp' function */
+
+      /* Build key transformation matrix function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (matr) transformation matrix.
+       */
+      matr ToMatr( VOID ) const
+      {
+        return matr::Scale(Scale) *
+          matr::RotateX(Angles.X) * matr::RotateY(Angles.Y) * matr::RotateZ(Angles.Z) *
+          matr::Translate(Pos);
+      } /* End of 'ToMatr' function */
+    }; /* End of 'transform_key' class */
+
+    /* Keys track class */
+    template<typename key>
+      class anim_track : public std::vector<key>
+      {
+      public:
+        /* Add key (keeping time order) function.
+         * ARGUMENTS:
+         *   - key:
+         *       const key &K;
+         * RETURNS: None.
+         */
+        VOID AddKey( const key &K )
+        {
+          auto Pos = std::upper_bound(this->begin(), this->end(), K,
+            []( const key &A, const key &B ){ return A.Time < B.Time; });
+
+          this->insert(Pos, K);
+        } /* End of 'AddKey' function */
+
+        /* Get interpolated key at specified time function.
+         * ARGUMENTS:
+         *   - time:
+         *       REAL Time;
+         * RETURNS:
+         *   (key) interpolated key.
+         */
+        key Get( REAL Time ) const
+        {
+          if (Time <= this->front().Time)
+            return this->front();
+          if (Time >= this->back().Time)
+            return this->back();
+
+          auto Next = std::upper_bound(this->begin(), this->end(), Time,
+            []( REAL T, const key &K ){ return T < K.Time; });
+          auto Prev = Next - 1;
+          REAL Len = Next->Time - Prev->Time;
+
+          return key::Lerp(*Prev, *Next, Len > 0 ? (Time - Prev->Time) / Len : 0);
+        } /* End of 'Get' function */
+      }; /* End of 'anim_track' class */
+
+    /* Scene animation class */
+    class animation
+    {
+    public:
+      /* Shape transformation track class */
+      class shape_track
+      {
+      public:
+        shape *Shp;                           // Animated shape
+        matr Base;                            // Shape own transformation
+        anim_track<transform_key> Keys;       // Transformation keys
+      }; /* End of 'shape_track' class */
+
+      anim_track<camera_key> CameraKeys;      // Camera path
+      std::vector<shape_track> ShapeTracks;   // Animated shapes
+
+      /* Get (or create) shape track function.
+       * ARGUMENTS:
+       *   - shape:
+       *       shape *Shp;
+       * RETURNS:
+       *   (shape_track &) shape track.
+       */
+      shape_track & Track( shape *Shp )
+      {
+        for (auto &Tr : ShapeTracks)
+          if (Tr.Shp == Shp)
+            return Tr;
+        ShapeTracks.push_back({Shp, Shp->GetMatr(), {}});
+        return ShapeTracks.back();
+      } /* End of 'Track' function */
+
+      /* Check if animation has any key function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if no keys, FALSE otherwise.
+       */
+      BOOL IsEmpty( VOID ) const
+      {
+        return CameraKeys.empty() && ShapeTracks.empty();
+      } /* End of 'IsEmpty' function */
+
+      /* Get animation time range function.
+       * ARGUMENTS:
+       *   - time range to be set:
+       *       REAL *Start, *End;
+       * RETURNS: None.
+       */
+      VOID GetTimeRange( REAL *Start, REAL *End ) const
+      {
+        BOOL IsFirst = TRUE;
+
+        *Start = *End = 0;
+        auto Update =
+          [&]( REAL T0, REAL T1 )
+          {
+            if (IsFirst || T0 < *Start)
+              *Start = T0;
+            if (IsFirst || T1 > *End)
+              *End = T1;
+            IsFirst = FALSE;
+          };
+        if (!CameraKeys.empty())
+          Update(CameraKeys.front().Time, CameraKeys.back().Time);
+        for (auto &Tr : ShapeTracks)
+          if (!Tr.Keys.empty())
+            Update(Tr.Keys.front().Time, Tr.Keys.back().Time);
+      } /* End of 'GetTimeRange' function */
+
+      /* Store shapes current transformations as base ones function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Bind( VOID )
+      {
+        for (auto &Tr : ShapeTracks)
+          Tr.Base = Tr.Shp->GetMatr();
+      } /* End of 'Bind' function */
+
+      /* Set camera and shapes to animation state at specified time function.
+       * ARGUMENTS:
+       *   - time:
+       *       REAL Time;
+       *   - camera:
+       *       camera &Cam;
+       * RETURNS: None.
+       */
+      VOID Apply( REAL Time, camera &Cam ) const
+      {
+        if (!CameraKeys.empty())
+        {
+          camera_key K = CameraKeys.Get(Time);
+
+          Cam.SetLocAtUp(K.Loc, K.At, K.Up);
+        }
+        for (auto &Tr : ShapeTracks)
+          if (!Tr.Keys.empty())
+            Tr.Shp->SetMatr(Tr.Base * Tr.Keys.Get(Time).ToMatr());
+      } /* End of 'Apply' function */
+    }; /* End of 'animation' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__anim_h_
+
+/* END OF 'anim.h' FILE */
@@ -0,0 +1,323 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        denoise.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's edge-aware (a-trous wavelet) denoiser header file.
+ * NOTE:        Filter works on linear pixel colors divided by primary hit
+ *              albedo (illumination) and is stopped on edges by primary
+ *              hit normal, depth and albedo differences and by luminance
+ *              difference relative to estimated noise (variance is
+ *              filtered together with color). Each pass reads one buffer
+ *              and writes other, so tiles of pass may be filtered by
+ *              different threads.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __denoise_h_
+#define __denoise_h_
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "rt_def.h"
+#include "frame.h"
+#include "tiles.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Pixel primary hits accumulator class */
+    class aux_texel
+    {
+    public:
+      vec3 N;                       // Sum of hits normals (facing viewer)
+      REAL Depth = 0;               // Sum of hits distances
+      vec3 Albedo;                  // Sum of hits albedo
+      INT Hits = 0;                 // Hits count
+
+      /* Add primary hit function.
+       * ARGUMENTS:
+       *   - hit normal, distance and albedo:
+       *       const vec3 &NewN;
+       *       REAL NewDepth;
+       *       const vec3 &NewAlbedo;
+       * RETURNS: None.
+       */
+      VOID Add( const vec3 &NewN, REAL NewDepth, const vec3 &NewAlbedo )
+      {
+        N += NewN;
+        Depth += NewDepth;
+        Albedo += NewAlbedo;
+        Hits++;
+      } /* End of 'Add' function */
+    }; /* End of 'aux_texel' class */
+
+    /* Frame auxiliary (denoiser guide) buffers class */
+    class aux_buffers
+    {
+    public:
+      INT W = 0, H = 0;             // Buffers size
+      std::vector<vec3>
+        Color,                      // Linear (not clamped) pixel colors
+        Normal,                     // Primary hit normals (zero if no hit)
+        Albedo;                     // Primary hit albedo
+      std::vector<REAL> Depth;      // Primary hit distances (0 if no hit)
+
+      /* Resize buffers function.
+       * ARGUMENTS:
+       *   - frame size:
+       *       INT NewW, NewH;
+       * RETURNS: None.
+       */
+      VOID Resize( INT NewW, INT NewH )
+      {
+        UINT_PTR Size = (UINT_PTR)NewW * NewH;
+
+        W = NewW;
+        H = NewH;
+        Color.resize(Size);
+        Normal.resize(Size);
+        Albedo.resize(Size);
+        Depth.resize(Size);
+      } /* End of 'Resize' function */
+
+      /* Store pixel function.
+       * ARGUMENTS:
+       *   - pixel coordinates:
+       *       INT X, Y;
+       *   - pixel color:
+       *       const vec3 &C;
+       *   - pixel primary hits:
+       *       const aux_texel &T;
+       *   - pixel samples count:
+       *       INT Count;
+       * RETURNS: None.
+       */
+      VOID Put( INT X, INT Y, const vec3 &C, const aux_texel &T, INT Count )
+      {
+        UINT_PTR p = (UINT_PTR)Y * W + X;
+
+        Color[p] = C;
+        if (T.Hits == 0)
+        {
+          Normal[p] = vec3(0);
+          Depth[p] = 0;
+          Albedo[p] = vec3(1);
+          return;
+        }
+        Normal[p] = T.N.Len2() > 0 ? T.N.Normalizing() : vec3(0);
+        Depth[p] = T.Depth / T.Hits;
+        // Background samples have unit albedo (color is illumination)
+        Albedo[p] = (T.Albedo + vec3(Count - T.Hits)) / Count;
+      } /* End of 'Put' function */
+    }; /* End of 'aux_buffers' class */
+
+    /* Edge-aware a-trous wavelet denoiser class */
+    class denoiser
+    {
+    public:
+      INT Iterations = 5;           // Filter passes count (pass i step is 2^i pixels)
+      INT NormalPower = 6;          // Normals cosine power is 2^NormalPower
+      REAL
+        SigmaColor = 4,             // Luminance difference sigma (in luminance standard deviations)
+        SigmaDepth = 0.02,          // Relative distance difference sigma per pixel step
+        SigmaAlbedo = 0.1;          // Albedo difference sigma
+
+    private:
+      static constexpr REAL AlbedoBias = 0.5;   // Albedo addition (keeps dark texels from amplifying noise)
+      static constexpr REAL Kernel[5] {1.0 / 16, 1.0 / 4, 3.0 / 8, 1.0 / 4, 1.0 / 16}; // B3 spline kernel
+      const aux_buffers *Aux = nullptr;         // Guide buffers
+      std::vector<vec3> Src, Dst;               // Illumination ping-pong buffers
+      std::vector<REAL> VarSrc, VarDst;         // Luminance variance ping-pong buffers
+
+      /* Get color luminance function.
+       * ARGUMENTS:
+       *   - color:
+       *       const vec3 &C;
+       * RETURNS:
+       *   (REAL) luminance.
+       */
+      static REAL Luminance( const vec3 &C )
+      {
+        return 0.2126 * C.X + 0.7152 * C.Y + 0.0722 * C.Z;
+      } /* End of 'Luminance' function */
+
+      /* Get geometry (edge stopping) weight of pixels pair function.
+       * ARGUMENTS:
+       *   - pixels:
+       *       UINT_PTR p, q;
+       *   - pixels distance (in pixels):
+       *       INT Dist;
+       * RETURNS:
+       *   (REAL) weight in [0..1].
+       */
+      REAL GeomWeight( UINT_PTR p, UINT_PTR q, INT Dist ) const
+      {
+        REAL Zp = Aux->Depth[p], Zq = Aux->Depth[q];
+
+        // Hit and background pixels are never mixed
+        if ((Zp > 0) != (Zq > 0))
+          return 0;
+        vec3 Da = Aux->Albedo[q] - Aux->Albedo[p];
+        REAL e = (Da & Da) / (SigmaAlbedo * SigmaAlbedo);
+
+        if (Zp == 0)
+          return exp(-e);
+
+        REAL nn = Aux->Normal[p] & Aux->Normal[q];
+
+        if (nn <= 0)
+          return 0;
+        for (INT k = 0; k < NormalPower; k++)
+          nn *= nn;
+        return nn * exp(-e - fabs(Zp - Zq) / (SigmaDepth * Zp * Dist + Threshold));
+      } /* End of 'GeomWeight' function */
+
+    public:
+      /* Start filtering function.
+       * ARGUMENTS:
+       *   - guide buffers (kept until 'End' call):
+       *       const aux_buffers &NewAux;
+       * RETURNS: None.
+       */
+      VOID Begin( const aux_buffers &NewAux )
+      {
+        Aux = &NewAux;
+        Src.resize(Aux->Color.size());
+        Dst.resize(Aux->Color.size());
+        VarSrc.resize(Aux->Color.size());
+        VarDst.resize(Aux->Color.size());
+        for (UINT_PTR p = 0; p < Src.size(); p++)
+        {
+          const vec3 &C = Aux->Color[p], &A = Aux->Albedo[p];
+
+          Src[p] = vec3(C.X / (A.X + AlbedoBias), C.Y / (A.Y + AlbedoBias), C.Z / (A.Z + AlbedoBias));
+        }
+      } /* End of 'Begin' function */
+
+      /* Estimate tile pixels luminance variance (by neighbours on the same surface) function.
+       * ARGUMENTS:
+       *   - tile:
+       *       const tile &T;
+       * RETURNS: None.
+       */
+      VOID Estimate( const tile &T )
+      {
+        const INT W = Aux->W, H = Aux->H;
+
+        for (INT y = T.Y0; y < T.Y0 + T.H; y++)
+          for (INT x = T.X0; x < T.X0 + T.W; x++)
+          {
+            UINT_PTR p = (UINT_PTR)y * W + x;
+            REAL S = 0, S2 = 0, WSum = 0;
+
+            for (INT qy = (std::max)(y - 2, 0); qy <= (std::min)(y + 2, H - 1); qy++)
+              for (INT qx = (std::max)(x - 2, 0); qx <= (std::min)(x + 2, W - 1); qx++)
+              {
+                UINT_PTR q = (UINT_PTR)qy * W + qx;
+                REAL w = GeomWeight(p, q, abs(qx - x) + abs(qy - y)), l = Luminance(Src[q]);
+
+                S += w * l;
+                S2 += w * l * l;
+                WSum += w;
+              }
+            S /= WSum;
+            VarSrc[p] = (std::max)(S2 / WSum - S * S, (REAL)0);
+          }
+      } /* End of 'Estimate' function */
+
+      /* Filter tile by one pass function.
+       * ARGUMENTS:
+       *   - pass number:
+       *       INT Pass;
+       *   - tile:
+       *       const tile &T;
+       * RETURNS: None.
+       */
+      VOID Filter( INT Pass, const tile &T )
+      {
+        const INT Step = 1 << Pass, W = Aux->W, H = Aux->H;
+
+        for (INT y = T.Y0; y < T.Y0 + T.H; y++)
+          for (INT x = T.X0; x < T.X0 + T.W; x++)
+          {
+            UINT_PTR p = (UINT_PTR)y * W + x;
+            REAL
+              Lp = Luminance(Src[p]),
+              InvSigmaL = 1 / (SigmaColor * sqrt(VarSrc[p]) + Threshold),
+              WSum = 0, VarSum = 0;
+            vec3 Sum;
+
+            for (INT j = 0; j < 5; j++)
+            {
+              INT qy = y + (j - 2) * Step;
+
+              if (qy < 0 || qy >= H)
+                continue;
+              for (INT i = 0; i < 5; i++)
+              {
+                INT qx = x + (i - 2) * Step;
+
+                if (qx < 0 || qx >= W)
+                  continue;
+                UINT_PTR q = (UINT_PTR)qy * W + qx;
+                REAL w = q == p ? Kernel[2] * Kernel[2] :
+                  Kernel[i] * Kernel[j] * GeomWeight(p, q, Step * (abs(i - 2) + abs(j - 2))) *
+                    exp(-fabs(Luminance(Src[q]) - Lp) * InvSigmaL);
+
+                Sum += Src[q] * w;
+                VarSum += w * w * VarSrc[q];
+                WSum += w;
+              }
+            }
+            Dst[p] = Sum / WSum;
+            VarDst[p] = VarSum / (WSum * WSum);
+          }
+      } /* End of 'Filter' function */
+
+      /* Finish pass (after all tiles are processed) function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID EndPass( VOID )
+      {
+        std::swap(Src, Dst);
+        std::swap(VarSrc, VarDst);
+      } /* End of 'EndPass' function */
+
+      /* Finish filtering and store result to frame function.
+       * ARGUMENTS:
+       *   - frame:
+       *       frame &Frm;
+       * RETURNS: None.
+       */
+      VOID End( frame &Frm )
+      {
+        for (INT y = 0; y < Aux->H; y++)
+          for (INT x = 0; x < Aux->W; x++)
+          {
+            UINT_PTR p = (UINT_PTR)y * Aux->W + x;
+            const vec3 &I = Src[p], &A = Aux->Albedo[p];
+
+            Frm.PutPixel(x, y, frame::ToRGB(I.X * (A.X + AlbedoBias), I.Y * (A.Y + AlbedoBias),
+                                            I.Z * (A.Z + AlbedoBias)));
+          }
+        Aux = nullptr;
+      } /* End of 'End' function */
+    }; /* End of 'denoiser' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__denoise_h_
+
+/* END OF 'denoise.h' FILE */
@@ -21,13 +21,20 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
 #include <filesystem>
 
 #include "mem/memtools.h"
 #include "rt_def.h"
 
 #pragma pack(push, 1)
+#ifdef _WIN32
 #include <tgahead.h>
+#else  // _WIN32
+#include "port/port_tga.h"
+#endif // _WIN32
 #pragma pack(pop)
 
 /* Project namespace */
@@ -115,6 +122,52 @@ namespace pirt
         return Pixels[Y * W + X];
       } /* End of 'PutPixel' function */
 
+      /* Put pixels rectangle function.
+       * ARGUMENTS:
+       *   - rectangle left-top corner:
+       *       INT X0, Y0;
+       *   - rectangle size:
+       *       INT RectW, RectH;
+       *   - rectangle pixels (row by row):
+       *       const DWORD *Src;
+       * RETURNS: None.
+       */
+      VOID PutRect( INT X0, INT Y0, INT RectW, INT RectH, const DWORD *Src )
+      {
+        // Lock access
+        const std::lock_guard<std::recursive_mutex> lock(frame_mutex);
+
+        // Clipping
+        if (X0 < 0 || Y0 < 0 || X0 + RectW > W || Y0 + RectH > H)
+          return;
+
+        for (INT y = 0; y < RectH; y++)
+          std::memcpy(Pixels + (Y0 + y) * W + X0, Src + y * RectW, (UINT_PTR)RectW * 4);
+      } /* End of 'PutRect' function */
+
+      /* Get pixels rectangle function.
+       * ARGUMENTS:
+       *   - rectangle left-top corner:
+       *       INT X0, Y0;
+       *   - rectangle size:
+       *       INT RectW, RectH;
+       *   - destination buffer (row by row):
+       *       DWORD *Dst;
+       * RETURNS: None.
+       */
+      VOID GetRect( INT X0, INT Y0, INT RectW, INT RectH, DWORD *Dst )
+      {
+        // Lock access
+        const std::lock_guard<std::recursive_mutex> lock(frame_mutex);
+
+        // Clipping
+        if (X0 < 0 || Y0 < 0 || X0 + RectW > W || Y0 + RectH > H)
+          return;
+
+        for (INT y = 0; y < RectH; y++)
+          std::memcpy(Dst + y * RectW, Pixels + (Y0 + y) * W + X0, (UINT_PTR)RectW * 4);
+      } /* End of 'GetRect' function */
+
       /* Fill frame with specified color function.
        * ARGUMENTS:
        *   - pixels color:
@@ -137,6 +190,7 @@ namespace pirt
   #endif
       } /* End of 'Fill' function */
 
+#ifdef _WIN32
       /* Blit frame to device context function.
        * ARGUMENTS:
        *   - device context:
@@ -172,6 +226,7 @@ namespace pirt
         StretchDIBits(hDC, X, Y, DrawW, DrawH, OffX, OffY, W, H, Pixels,
           (BITMAPINFO *)&bih, DIB_RGB_COLORS, SRCCOPY);
       } /* End of 'Draw' function */
+#endif // _WIN32
 
       /* Convert float point 0..1 range color to DWORD function.
        * ARGUMENTS:
@@ -218,7 +273,6 @@ namespace pirt
       /* Class destructor */
       ~frame( VOID )
       {
-        std::cout << "\nFrame destroyed\n";
         Resize(0, 0);
       } /* End of '~frame' function */
 
@@ -306,17 +360,19 @@ namespace pirt
       BOOL AutoSaveTGA( const std::string &Comments = "",
                         const std::tuple<INT, INT, INT> &JobTime = {0, 0, 0} )
       {
-        SYSTEMTIME st;
-
-        GetLocalTime(&st);
+        auto Now = std::chrono::system_clock::now();
+        std::time_t t = std::chrono::system_clock::to_time_t(Now);
+        INT ms = (INT)(std::chrono::duration_cast<std::chrono::milliseconds>(
+                         Now.time_since_epoch()).count() % 1000);
+        std::tm st = *std::localtime(&t);
         CHAR Buf[300];
 
         std::string path("bin/images/AutoSave");
         std::filesystem:: create_directories(path);  // <filesystem>
 
-        wsprintf(Buf, "%04d%02d%02d_%02d%02d%02d_%03d_%02d",
-          st.wYear, st.wMonth, st.wDay, st.wHour,
-          st.wMinute, st.wSecond, st.wMilliseconds,
+        std::snprintf(Buf, sizeof(Buf), "%04d%02d%02d_%02d%02d%02d_%03d_%02d",
+          st.tm_year + 1900, st.tm_mon + 1, st.tm_mday, st.tm_hour,
+          st.tm_min, st.tm_sec, ms,
           rand() % 90);
         return SaveTGA(path + "/" + Buf + ".tga", Comments, JobTime);
       } /* End of 'AutoSaveTGA' function */
@@ -0,0 +1,253 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        area.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's area (spherical and rectangular) lights header file.
+ * NOTE:        Shading uses light center direction and attenuation,
+ *              area is used only for shadow (visibility) sampling.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __area_h_
+#define __area_h_
+
+#include <cmath>
+#include <algorithm>
+
+#include "../rt_def.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Lights namespace */
+    namespace lights
+    {
+      /* Fill light info by light center function.
+       * ARGUMENTS:
+       *   - light:
+       *       const light &Lgh;
+       *   - light center:
+       *       const vec3 &C;
+       *   - point:
+       *       const vec3 &P;
+       *   - light_info:
+       *       light_info *L;
+       * RETURNS:
+       *   (REAL) attenuation factor.
+       */
+      inline REAL CenterShadow( const light &Lgh, const vec3 &C, const vec3 &P, light_info *L )
+      {
+        vec3 D = C - P;
+        REAL Len = !D;
+
+        L->Color = Lgh.Color;
+        L->Dist = Len;
+        L->L = Len > 0 ? D / Len : vec3(0, 1, 0);
+        return Lgh.Attenuation(Len);
+      } /* End of 'CenterShadow' function */
+
+      /* Spherical light class */
+      class sphere_light : public light
+      {
+      public:
+        vec3 Coord;  // Center of light
+        REAL Radius; // Radius of light
+
+        /* Constructor by all parameters.
+         * ARGUMENTS:
+         *   - attenuation coefficients:
+         *       REAL cc, cl, cq;
+         *   - color:
+         *       vec3 color;
+         *   - center and radius:
+         *       vec3 coord;
+         *       REAL radius;
+         *   - shadow samples grid side:
+         *       INT side = 4;
+         */
+        sphere_light( REAL cc, REAL cl, REAL cq, vec3 color, vec3 coord, REAL radius, INT side = 4 ) :
+          light(cc, cl, cq, color), Coord(coord), Radius(radius)
+        {
+          SamplesSide = side;
+        } /* End of 'sphere_light' function */
+
+        /* Light shadow evaluvating function.
+         * ARGUMENTS:
+         *   - point:
+         *       const vec3 &P;
+         *   - light_info:
+         *       light_info *L;
+         * RETURNS:
+         *   (REAL) attenuation factor.
+         */
+        REAL Shadow( const vec3 &P, light_info *L ) override
+        {
+          return CenterShadow(*this, Coord, P, L);
+        } /* End of 'Shadow' function */
+
+        /* Get light influence sphere function.
+         * ARGUMENTS:
+         *   - contribution cut off:
+         *       REAL Cutoff;
+         *   - sphere to be set:
+         *       vec3 *C;
+         *       REAL *R;
+         * RETURNS:
+         *   (BOOL) TRUE if light is bounded, FALSE if it may influence any point.
+         */
+        BOOL GetInfluence( REAL Cutoff, vec3 *C, REAL *R ) const override
+        {
+          *C = Coord;
+          *R = InfluenceRadius(Cutoff);
+          return *R >= 0;
+        } /* End of 'GetInfluence' function */
+
+        /* Get light surface sample point function.
+         * ARGUMENTS:
+         *   - lit point:
+         *       const vec3 &P;
+         *   - sample in [0, 1)^2:
+         *       const vec2 &U;
+         * RETURNS:
+         *   (vec3) point of sphere silhouette disk (facing lit point).
+         */
+        vec3 SamplePoint( const vec3 &P, const vec2 &U ) const override
+        {
+          vec3 W = Coord - P;
+
+          if (W.Len2() <= Radius * Radius)
+            return Coord;
+          W.Normalize();
+          vec3
+            A = fabs(W.X) > 0.5 ? vec3(0, 1, 0) : vec3(1, 0, 0),
+            Du = (A % W).Normalizing(),
+            Dv = W % Du;
+
+          // Concentric square to disk mapping (keeps strata areas)
+          REAL a = 2 * U.X - 1, b = 2 * U.Y - 1, r, phi;
+
+          if (a == 0 && b == 0)
+            return Coord;
+          if (fabs(a) > fabs(b))
+            r = a, phi = PI_4 * b / a;
+          else
+            r = b, phi = PI_2 - PI_4 * a / b;
+          return Coord + (Du * cos(phi) + Dv * sin(phi)) * (r * Radius);
+        } /* End of 'SamplePoint' function */
+
+        /* Get light surface bound box function.
+         * ARGUMENTS:
+         *   - bound box to be set:
+         *       vec3 *Min, *Max;
+         * RETURNS: None.
+         */
+        VOID GetBound( vec3 *Min, vec3 *Max ) const override
+        {
+          *Min = Coord - vec3(Radius);
+          *Max = Coord + vec3(Radius);
+        } /* End of 'GetBound' function */
+      }; /* End of 'sphere_light' class */
+
+      /* Rectangular light class */
+      class rect_light : public light
+      {
+      public:
+        vec3 Corner;  // Rectangle corner
+        vec3 E1, E2;  // Rectangle edges from corner
+
+        /* Constructor by all parameters.
+         * ARGUMENTS:
+         *   - attenuation coefficients:
+         *       REAL cc, cl, cq;
+         *   - color:
+         *       vec3 color;
+         *   - corner and edges:
+         *       vec3 corner, e1, e2;
+         *   - shadow samples grid side:
+         *       INT side = 4;
+         */
+        rect_light( REAL cc, REAL cl, REAL cq, vec3 color, vec3 corner, vec3 e1, vec3 e2, INT side = 4 ) :
+          light(cc, cl, cq, color), Corner(corner), E1(e1), E2(e2)
+        {
+          SamplesSide = side;
+        } /* End of 'rect_light' function */
+
+        /* Light shadow evaluvating function.
+         * ARGUMENTS:
+         *   - point:
+         *       const vec3 &P;
+         *   - light_info:
+         *       light_info *L;
+         * RETURNS:
+         *   (REAL) attenuation factor.
+         */
+        REAL Shadow( const vec3 &P, light_info *L ) override
+        {
+          return CenterShadow(*this, Corner + (E1 + E2) * 0.5, P, L);
+        } /* End of 'Shadow' function */
+
+        /* Get light influence sphere function.
+         * ARGUMENTS:
+         *   - contribution cut off:
+         *       REAL Cutoff;
+         *   - sphere to be set:
+         *       vec3 *C;
+         *       REAL *R;
+         * RETURNS:
+         *   (BOOL) TRUE if light is bounded, FALSE if it may influence any point.
+         */
+        BOOL GetInfluence( REAL Cutoff, vec3 *C, REAL *R ) const override
+        {
+          *C = Corner + (E1 + E2) * 0.5;
+          *R = InfluenceRadius(Cutoff);
+          return *R >= 0;
+        } /* End of 'GetInfluence' function */
+
+        /* Get light surface sample point function.
+         * ARGUMENTS:
+         *   - lit point:
+         *       const vec3 &P;
+         *   - sample in [0, 1)^2:
+         *       const vec2 &U;
+         * RETURNS:
+         *   (vec3) rectangle point.
+         */
+        vec3 SamplePoint( const vec3 &P, const vec2 &U ) const override
+        {
+          return Corner + E1 * U.X + E2 * U.Y;
+        } /* End of 'SamplePoint' function */
+
+        /* Get light surface bound box function.
+         * ARGUMENTS:
+         *   - bound box to be set:
+         *       vec3 *Min, *Max;
+         * RETURNS: None.
+         */
+        VOID GetBound( vec3 *Min, vec3 *Max ) const override
+        {
+          vec3 P[4] = {Corner, Corner + E1, Corner + E2, Corner + E1 + E2};
+
+          *Min = *Max = P[0];
+          for (INT i = 1; i < 4; i++)
+          {
+            *Min = vec3((std::min)(Min->X, P[i].X), (std::min)(Min->Y, P[i].Y), (std::min)(Min->Z, P[i].Z));
+            *Max = vec3((std::max)(Max->X, P[i].X), (std::max)(Max->Y, P[i].Y), (std::max)(Max->Z, P[i].Z));
+          }
+        } /* End of 'GetBound' function */
+      }; /* End of 'rect_light' class */
+    } /* end of 'lights' namespace */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__area_h_
+
+/* END OF 'area.h' FILE */
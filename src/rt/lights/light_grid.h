@@ -0,0 +1,208 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        light_grid.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's lights influence uniform grid header file.
+ * NOTE:        Every grid cell keeps (in scene order) numbers of lights
+ *              whose influence sphere overlaps the cell. Unbounded
+ *              lights are kept in every cell and outside the grid.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __light_grid_h_
+#define __light_grid_h_
+
+#include <vector>
+#include <span>
+#include <cmath>
+#include <algorithm>
+
+#include "../rt_def.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Lights influence grid class */
+    class light_grid
+    {
+    private:
+      static constexpr INT MaxSide = 32;        // Maximal cells count by axis
+      BOOL IsUsed = FALSE;                      // Grid is built (some lights are bounded) flag
+      vec3 Min, CellSize;                       // Grid origin and cell size
+      INT SX = 0, SY = 0, SZ = 0;               // Cells count by axes
+      std::vector<INT> CellStart;               // Cells lights ranges in 'CellLights' (cells count + 1)
+      std::vector<INT> CellLights;              // Cells lights numbers
+      std::vector<INT> Unbounded;               // Unbounded lights numbers
+      std::vector<INT> All;                     // All lights numbers (grid is not used)
+      std::vector<vec3> Centers;                // Bounded lights influence spheres centers
+      std::vector<REAL> Radiuses2;              // Lights influence spheres squared radiuses (negative if unbounded)
+
+    public:
+      /* Build grid function.
+       * ARGUMENTS:
+       *   - scene lights:
+       *       const std::vector<light *> &Lights;
+       *   - contribution cut off (0 - all lights are unbounded):
+       *       REAL Cutoff;
+       * RETURNS: None.
+       */
+      VOID Build( const std::vector<light *> &Lights, REAL Cutoff )
+      {
+        INT n = (INT)Lights.size();
+        vec3 Max;
+        REAL SumR = 0;
+        INT Bounded = 0;
+
+        Centers.resize(n);
+        Radiuses2.resize(n);
+        Unbounded.clear();
+        All.resize(n);
+        for (INT i = 0; i < n; i++)
+        {
+          REAL R;
+
+          All[i] = i;
+          if (Cutoff <= 0 || !Lights[i]->GetInfluence(Cutoff, &Centers[i], &R))
+          {
+            Radiuses2[i] = -1;
+            Unbounded.push_back(i);
+            continue;
+          }
+          Radiuses2[i] = R * R;
+          vec3 B0 = Centers[i] - vec3(R), B1 = Centers[i] + vec3(R);
+
+          if (Bounded++ == 0)
+            Min = B0, Max = B1;
+          Min = vec3((std::min)(Min.X, B0.X), (std::min)(Min.Y, B0.Y), (std::min)(Min.Z, B0.Z));
+          Max = vec3((std::max)(Max.X, B1.X), (std::max)(Max.Y, B1.Y), (std::max)(Max.Z, B1.Z));
+          SumR += R;
+        }
+        IsUsed = Bounded > 0;
+        if (!IsUsed)
+          return;
+
+        // Cell side is about average influence radius
+        REAL Side = (std::max)(SumR / Bounded, Threshold);
+        auto Cells =
+          [&]( REAL Len ) -> INT
+          {
+            return std::clamp((INT)ceil(Len / Side), 1, MaxSide);
+          };
+
+        SX = Cells(Max.X - Min.X);
+        SY = Cells(Max.Y - Min.Y);
+        SZ = Cells(Max.Z - Min.Z);
+        CellSize = vec3((std::max)(Max.X - Min.X, Threshold) / SX,
+                        (std::max)(Max.Y - Min.Y, Threshold) / SY,
+                        (std::max)(Max.Z - Min.Z, Threshold) / SZ);
+
+        // Two passes: count cells lights, then fill ranges
+        std::vector<INT> Count((UINT_PTR)SX * SY * SZ + 1, 0);
+
+        for (INT Pass = 0; Pass < 2; Pass++)
+        {
+          if (Pass == 1)
+          {
+            CellStart.assign(Count.size(), 0);
+            for (UINT_PTR c = 1; c < Count.size(); c++)
+              CellStart[c] = CellStart[c - 1] + Count[c - 1];
+            CellLights.resize(CellStart.back());
+            std::fill(Count.begin(), Count.end(), 0);
+          }
+          for (INT i = 0; i < n; i++)
+          {
+            INT X0 = 0, Y0 = 0, Z0 = 0, X1 = SX - 1, Y1 = SY - 1, Z1 = SZ - 1;
+
+            if (Radiuses2[i] >= 0)
+            {
+              REAL R = sqrt(Radiuses2[i]);
+
+              X0 = Cell(Centers[i].X - R, Min.X, CellSize.X, SX);
+              Y0 = Cell(Centers[i].Y - R, Min.Y, CellSize.Y, SY);
+              Z0 = Cell(Centers[i].Z - R, Min.Z, CellSize.Z, SZ);
+              X1 = Cell(Centers[i].X + R, Min.X, CellSize.X, SX);
+              Y1 = Cell(Centers[i].Y + R, Min.Y, CellSize.Y, SY);
+              Z1 = Cell(Centers[i].Z + R, Min.Z, CellSize.Z, SZ);
+            }
+            for (INT z = Z0; z <= Z1; z++)
+              for (INT y = Y0; y <= Y1; y++)
+                for (INT x = X0; x <= X1; x++)
+                {
+                  INT c = (z * SY + y) * SX + x;
+
+                  if (Pass == 1)
+                    CellLights[CellStart[c] + Count[c]] = i;
+                  Count[c]++;
+                }
+          }
+        }
+      } /* End of 'Build' function */
+
+      /* Get lights which may influence point function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3 &P;
+       * RETURNS:
+       *   (std::span<const INT>) lights numbers (in scene order).
+       */
+      std::span<const INT> Get( const vec3 &P ) const
+      {
+        if (!IsUsed)
+          return All;
+
+        vec3 D = P - Min;
+
+        if (D.X < 0 || D.Y < 0 || D.Z < 0 ||
+            D.X >= CellSize.X * SX || D.Y >= CellSize.Y * SY || D.Z >= CellSize.Z * SZ)
+          return Unbounded;
+
+        INT c =
+          (Cell(P.Z, Min.Z, CellSize.Z, SZ) * SY + Cell(P.Y, Min.Y, CellSize.Y, SY)) * SX +
+           Cell(P.X, Min.X, CellSize.X, SX);
+
+        return std::span<const INT>(CellLights.data() + CellStart[c], CellStart[c + 1] - CellStart[c]);
+      } /* End of 'Get' function */
+
+      /* Check if light may influence point function.
+       * ARGUMENTS:
+       *   - light number:
+       *       INT No;
+       *   - point:
+       *       const vec3 &P;
+       * RETURNS:
+       *   (BOOL) TRUE if point is in light influence sphere, FALSE otherwise.
+       */
+      BOOL IsInfluence( INT No, const vec3 &P ) const
+      {
+        return Radiuses2[No] < 0 || (P - Centers[No]).Len2() <= Radiuses2[No];
+      } /* End of 'IsInfluence' function */
+
+    private:
+      /* Get cell number by coordinate function.
+       * ARGUMENTS:
+       *   - coordinate, grid origin, cell size and cells count by axis:
+       *       REAL X, Min, Size;
+       *       INT Count;
+       * RETURNS:
+       *   (INT) clamped cell number.
+       */
+      static INT Cell( REAL X, REAL Min, REAL Size, INT Count )
+      {
+        return std::clamp((INT)floor((X - Min) / Size), 0, Count - 1);
+      } /* End of 'Cell' function */
+    }; /* End of 'light_grid' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__light_grid_h_
+
+/* END OF 'light_grid.h' FILE */
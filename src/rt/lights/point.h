@@ -5,7 +5,7 @@
 
 /* FILE:        point.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 25.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's point light header file.
  * NOTE:        None.
  * 
@@ -36,13 +36,13 @@ namespace pirt
         /* Constructor by all parameters.
          * ARGUMENTS:
          *   - attenuation coefficients:
-         *       DBL cc, cl, cq;
+         *       REAL cc, cl, cq;
          *   - color:
          *       vec3 color;
          *   - coordinates:
          *       vec3 coord;
          */
-        point_light( DBL cc, DBL cl, DBL cq, vec3 color, vec3 coord ) : light(cc, cl, cq, color), Coord(coord)
+        point_light( REAL cc, REAL cl, REAL cq, vec3 color, vec3 coord ) : light(cc, cl, cq, color), Coord(coord)
         {
         } /* End of 'point_light' function */
 
@@ -53,16 +53,33 @@ namespace pirt
          *   - light_info:
          *       light_info *L;
          * RETURNS:
-         *   (DBL) information about shadow.
+         *   (REAL) attenuation factor.
          */
-        DBL Shadow( const vec3 &P, light_info *L ) override
+        REAL Shadow( const vec3 &P, light_info *L ) override
         {
           L->Color = Color;
-          L->Dist = (P - Coord).Len2();
+          L->Dist = !(P - Coord);
           L->L = -(P - Coord).Normalizing();
 
-          return 1.0;
+          return Attenuation(L->Dist);
         } /* End of 'Shadow' function */
+
+        /* Get light influence sphere function.
+         * ARGUMENTS:
+         *   - contribution cut off:
+         *       REAL Cutoff;
+         *   - sphere to be set:
+         *       vec3 *C;
+         *       REAL *R;
+         * RETURNS:
+         *   (BOOL) TRUE if light is bounded, FALSE if it may influence any point.
+         */
+        BOOL GetInfluence( REAL Cutoff, vec3 *C, REAL *R ) const override
+        {
+          *C = Coord;
+          *R = InfluenceRadius(Cutoff);
+          return *R >= 0;
+        } /* End of 'GetInfluence' function */
       }; /* End of 'point_light' class */
     } /* end of 'lights' namespace */
   } /* end of 'rt' namespace */
@@ -7,8 +7,9 @@
  * PURPOSE     : Raytracing project.
  *               Materials of shapes declaration module.
  * PROGRAMMER  : IP5.
- * LAST UPDATE : 28.07.2024.
- * NOTE        : None.
+ * LAST UPDATE : 18.10.2026.
+ * NOTE        : Secondary rays start offset depends on renderer precision
+ *               (see 'REAL' in 'def.h').
  *
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum
@@ -26,9 +27,18 @@ namespace pirt
   namespace rt
   {
     /* Threshold coeficients */
-    static const DBL Treashold     = 0.00001;
-    static const DBL ColorThresold = 0.002;
-    static const DBL Threshold     = 0.00001;
+    static const REAL Treashold     = 0.00001;
+    static const REAL ColorThresold = 0.002;
+    static const REAL Threshold     = 0.00001;
+
+    /* Secondary (reflected, shadow) rays start offset from surface.
+     * Single precision hit points are exact to about 1e-7 of scene size,
+     * so rays start farther, otherwise they hit their own surface. */
+#ifdef PIRT_FLOAT
+    static const REAL RayOffset     = 0.001f;
+#else  // PIRT_FLOAT
+    static const REAL RayOffset     = 0.00001;
+#endif // PIRT_FLOAT
 
     /* Shading coefficient store class */
     class coef
@@ -45,18 +55,18 @@ namespace pirt
       /* Class constructor.
        * AGUMENTS:
        *   - color all components value:
-       *       DBL C;
+       *       REAL C;
        */
-      coef( DBL C ) : K(C, C, C), IsUsage(C > Threshold)
+      coef( REAL C ) : K(C, C, C), IsUsage(C > Threshold)
       {
       } /* End of 'coef' function */
 
       /* Class constructor.
        * AGUMENTS:
        *   - color component values:
-       *       DBL X, Y, Z;
+       *       REAL X, Y, Z;
        */
-      coef( DBL X, DBL Y, DBL Z ) :
+      coef( REAL X, REAL Y, REAL Z ) :
         K(X, Y, Z),
         IsUsage(X > Threshold ||
                 Y > Threshold ||
@@ -106,9 +116,9 @@ namespace pirt
       /* Get max component function.
        * ARGUMENTS: None.
        * RETURNS:
-       *   (DBL) max component.
+       *   (REAL) max component.
        */
-      DBL MaxComponent( VOID ) const
+      REAL MaxComponent( VOID ) const
       {
         return K.MaxComponent();
       } /* End of 'MaxComponent' function */
@@ -121,7 +131,7 @@ namespace pirt
       const struct MtlLibDataType
       {
         const vec3 Ka, Kd, Ks; /* Material coefficients */
-        const DBL Ph;          /* Phong coefficient */
+        const REAL Ph;         /* Phong coefficient */
       } SurfaceData;
     } SurfaceLib[] =
     {
@@ -158,6 +168,8 @@ namespace pirt
       /* Default constructor */
       surface() : Kr(0.1), Kt(0)
       {
+        for (INT i = 0; i < 8; ++i)
+          TexNum[i] = -1;
       } /* End of 'surface' function */
 
       /* Constructor by parameters.
@@ -165,9 +177,9 @@ namespace pirt
        *   - kads coef:
        *       vec3 ka, kd, ks;
        *   - phong coef:
-       *       DBL ph;
+       *       REAL ph;
        */
-      surface( vec3 ka, vec3 kd, vec3 ks, DBL ph ) : Ka(ka), Kd(kd), Ks(ks), Ph(ph), Kr(0.5), Kt(0)
+      surface( vec3 ka, vec3 kd, vec3 ks, REAL ph ) : Ka(ka), Kd(kd), Ks(ks), Ph(ph), Kr(0.5), Kt(0)
       {
         for (INT i = 0; i < 8; ++i)
           TexNum[i] = -1;
@@ -187,17 +199,19 @@ namespace pirt
             Kd = SurfaceLib[i].SurfaceData.Kd;
             Ks = SurfaceLib[i].SurfaceData.Ks;
             Ph = SurfaceLib[i].SurfaceData.Ph;
-            memset(TexNum, 0, sizeof(INT[8]));
+            for (INT t = 0; t < 8; ++t)
+              TexNum[t] = -1;
 
             return; // we finded true surface thats meen we may be leave.
           }
 
         // If no finded surface, then create default material
-        surface({0.05375, 0.05, 0.06625}, {0.18275, 0.17, 0.22525}, {0.332741, 0.328634, 0.346435}, 38.4);
+        *this = surface({0.05375, 0.05, 0.06625}, {0.18275, 0.17, 0.22525}, {0.332741, 0.328634, 0.346435}, 38.4);
+        Kr = 0.1;
       } /* End of 'surface' function */
 
       vec3 Ka, Kd, Ks;  // ambient, diffuse, specular
-      DBL Ph;           // Bui Tong Phong coefficient
+      REAL Ph;          // Bui Tong Phong coefficient
       coef Kr {}, Kt {};      // reflected, transmitted
 
       INT TexNum[8];    // Number of textures
@@ -5,9 +5,11 @@
 
 /* FILE:        material_manager.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 05.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's material manager header file.
- * NOTE:        None.
+ * NOTE:        Materials are kept in dense array of cache line aligned
+ *              slots, material number is index in it. Pointers to
+ *              materials are valid until next material adding.
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -16,6 +18,8 @@
 #ifndef __material_manager_h_
 #define __material_manager_h_
 
+#include <vector>
+
 #include "../rt_def.h"
 
 /* Base project namespace */
@@ -24,12 +28,19 @@ namespace pirt
   /* Ray tracing namespace */
   namespace rt
   {
+    /* Material stock slot (one or more whole cache lines) class */
+    class alignas(64) mtl_slot
+    {
+    public:
+      surface Surf;                 // Slot surface
+    }; /* End of 'mtl_slot' class */
+
     /* Material manager class */
     class mtl_manager
     {
     public:
       INT MtlCount;                 // Total count of all surfaces, needing for set unique number for every surfaces.
-      std::map<INT, surface> Stock; // Surface stock
+      std::vector<mtl_slot> Stock;  // Surface stock (indexed by material number)
 
       /* Default constructor */
       mtl_manager() : MtlCount(0)
@@ -47,7 +58,7 @@ namespace pirt
        */
       surface * AddMaterial( const surface &Surf )
       {
-        return &(Stock[MtlCount++] = Surf);
+        return &Stock[AddMaterialNo(Surf)].Surf;
       } /* End of 'AddMaterial' function */
 
       /* Add surface function.
@@ -59,9 +70,9 @@ namespace pirt
        */
       INT AddMaterialNo( const surface &Surf )
       {
-        Stock[MtlCount] = Surf;
+        Stock.push_back({Surf});
         return MtlCount++;
-      } /* End of 'AddMaterial' function */
+      } /* End of 'AddMaterialNo' function */
 
       /* Get surface by number in stock function.
        * ARGUMENTS:
@@ -72,11 +83,9 @@ namespace pirt
        */
       surface * GetSurfByNo( INT No )
       {
-        auto find = Stock.find(No);
-
-        if (find != Stock.end())
-          return &Stock[No];
-        return nullptr;
+        if (No < 0 || No >= MtlCount)
+          return nullptr;
+        return &Stock[No].Surf;
       } /* End of 'GetSurfByNo' function */
 
       /* Clear surface stock function.
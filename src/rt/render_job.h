@@ -0,0 +1,207 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        render_job.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's asynchronous render job header file.
+ * NOTE:        Only one job per scene may run at a time (scene render
+ *              flags and tile counter are shared). Tile callback is
+ *              called from render threads.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __render_job_h_
+#define __render_job_h_
+
+#include <future>
+#include <chrono>
+
+#include "rt_scene.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Asynchronous render job class */
+    class render_job
+    {
+    public:
+      /* Rendered tile callback type */
+      typedef std::function<VOID( const tile & )> tile_callback;
+
+    private:
+      scene &Scene;                             // Rendered scene
+      camera Camera;                            // Camera copy (caller may change own one)
+      frame &Frame;                             // Destination frame
+      tile_callback OnTile;                     // Tile callback
+      INT TilesCount;                           // Tiles in frame count
+      std::atomic_int TilesDone = 0;            // Rendered tiles count
+      std::chrono::steady_clock::time_point
+        StartTime;                              // Job start time
+      std::atomic<DBL> Time = 0;                // Job time (when finished)
+      std::promise<frame *> Promise;            // Result promise
+      std::shared_future<frame *> Result;       // Result future
+      std::thread Thread;                       // Job thread
+
+    public:
+      /* Start render job constructor.
+       * ARGUMENTS:
+       *   - scene:
+       *       scene &Scn;
+       *   - camera:
+       *       const camera &Cam;
+       *   - frame:
+       *       frame &Frm;
+       *   - rendered tile callback:
+       *       const tile_callback &NewOnTile = nullptr;
+       *   - is debug mode flag:
+       *       BOOL IsDebug = FALSE;
+       */
+      render_job( scene &Scn, const camera &Cam, frame &Frm,
+                  const tile_callback &NewOnTile = nullptr, BOOL IsDebug = FALSE ) :
+        Scene(Scn), Camera(Cam), Frame(Frm), OnTile(NewOnTile),
+        TilesCount(tile_grid(Frm.W, Frm.H, Scn.TileSize).Count()),
+        StartTime(std::chrono::steady_clock::now()), Result(Promise.get_future().share())
+      {
+        Scene.IsRenderActive = TRUE;
+        Scene.IsToBeStop = FALSE;
+        Scene.IsReadyToFinish = FALSE;
+        Thread = std::thread(
+          [this, IsDebug]( VOID )
+          {
+            BOOL IsDone = Scene.RenderTiles(Camera, Frame, 0, 1, IsDebug, 1,
+              [this]( const tile &T )
+              {
+                TilesDone++;
+                if (OnTile)
+                  OnTile(T);
+              });
+
+            Time = Elapsed();
+            Scene.IsRenderActive = FALSE;
+            Scene.IsToBeStop = FALSE;
+            Scene.IsReadyToFinish = TRUE;
+            Promise.set_value(IsDone ? &Frame : nullptr);
+          });
+      } /* End of 'render_job' function */
+
+      /* Destructor (cancels job and waits its finish) */
+      ~render_job( VOID )
+      {
+        if (!IsDone())
+          Cancel();
+        Thread.join();
+      } /* End of '~render_job' function */
+
+      /* Cancel job (render stops at next tile) function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Cancel( VOID )
+      {
+        Scene.IsToBeStop = TRUE;
+      } /* End of 'Cancel' function */
+
+      /* Check job finish (by completion or cancel) function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if job is finished, FALSE otherwise.
+       */
+      BOOL IsDone( VOID ) const
+      {
+        return Result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      } /* End of 'IsDone' function */
+
+      /* Wait job finish with timeout function.
+       * ARGUMENTS:
+       *   - timeout in seconds:
+       *       DBL Timeout;
+       * RETURNS:
+       *   (BOOL) TRUE if job is finished, FALSE otherwise.
+       */
+      BOOL Wait( DBL Timeout ) const
+      {
+        return Result.wait_for(std::chrono::duration<DBL>(Timeout)) == std::future_status::ready;
+      } /* End of 'Wait' function */
+
+      /* Get result future function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (std::shared_future<frame *>) future of rendered frame (nullptr if job is cancelled).
+       */
+      std::shared_future<frame *> Future( VOID ) const
+      {
+        return Result;
+      } /* End of 'Future' function */
+
+      /* Get rendered tiles count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) rendered tiles count.
+       */
+      INT Done( VOID ) const
+      {
+        return TilesDone;
+      } /* End of 'Done' function */
+
+      /* Get tiles count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) frame tiles count.
+       */
+      INT Count( VOID ) const
+      {
+        return TilesCount;
+      } /* End of 'Count' function */
+
+      /* Get job progress function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (DBL) progress in percents.
+       */
+      DBL Progress( VOID ) const
+      {
+        return TilesCount == 0 ? 100.0 : 100.0 * TilesDone / TilesCount;
+      } /* End of 'Progress' function */
+
+      /* Get job time function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (DBL) time from job start (or whole job time if finished) in seconds.
+       */
+      DBL Elapsed( VOID ) const
+      {
+        if (IsDone())
+          return Time;
+        return std::chrono::duration<DBL>(std::chrono::steady_clock::now() - StartTime).count();
+      } /* End of 'Elapsed' function */
+
+      /* Get estimated time to job finish function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (DBL) estimated time in seconds (negative if not known yet).
+       */
+      DBL ETA( VOID ) const
+      {
+        INT n = TilesDone;
+
+        if (IsDone())
+          return 0;
+        if (n == 0)
+          return -1;
+        return Elapsed() * (TilesCount - n) / n;
+      } /* End of 'ETA' function */
+    }; /* End of 'render_job' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__render_job_h_
+
+/* END OF 'render_job.h' FILE */
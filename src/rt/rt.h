@@ -16,7 +16,12 @@
 #ifndef __rt_h_
 #define __rt_h_
 
+#ifdef _WIN32
 #include "rt_win.h"
+#else  // _WIN32
+#include "frame.h"
+#include "rt_scene.h"
+#endif // _WIN32
 
 /* Simple shapes header files */
 #include "shapes/plane.h"
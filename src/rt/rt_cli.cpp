@@ -0,0 +1,980 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        rt_cli.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's headless command line renderer file.
+ * NOTE:        Scene file is a text file with one command per line
+ *              ('#' starts a comment):
+ *                camera Lx Ly Lz Ax Ay Az [Ux Uy Uz]
+ *                background R G B
+ *                ambient R G B
+ *                fog linear R G B Start End
+ *                fog exp R G B Density [Start]
+ *                fog height R G B Density Height Falloff [Start]
+ *                                  (path distance fog, fully fogged rays are
+ *                                   not traced further)
+ *                light Cc Cl Cq R G B X Y Z
+ *                spherelight Cc Cl Cq R G B X Y Z Radius [Side]
+ *                rectlight Cc Cl Cq R G B X Y Z E1x E1y E1z E2x E2y E2z [Side]
+ *                                  (area lights, Side - shadow samples
+ *                                   grid side, default 4)
+ *                plane Nx Ny Nz Px Py Pz [texture.g24]
+ *                sphere Cx Cy Cz Radius [material name]
+ *                box X1 Y1 Z1 X2 Y2 Z2 [material name]
+ *                tor Cx Cy Cz R1 R2
+ *                g3dm FileName
+ *                obj FileName
+ *                mode 0|1          (last shape 'Mode' usage flag)
+ *                translate X Y Z   (last shape transformations,
+ *                rotatex Angle      applied in order of writing)
+ *                rotatey Angle
+ *                rotatez Angle
+ *                scale X Y Z
+ *                camkey Time Lx Ly Lz Ax Ay Az [Ux Uy Uz]
+ *                                  (camera path key)
+ *                key Time Tx Ty Tz [Ax Ay Az [Sx Sy Sz]]
+ *                                  (last shape animation key: scale,
+ *                                   rotations in degrees, translation,
+ *                                   applied after its transformations)
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <ctime>
+#include <chrono>
+#include <future>
+
+#include "pirt.h"
+#include "rt_cli.h"
+#include "render_job.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Default constructor */
+    rt_cli::rt_cli( VOID ) : Frame(), Camera(), Scene()
+    {
+    } /* End of 'rt_cli::rt_cli' function */
+
+    /* Default destructor */
+    rt_cli::~rt_cli( VOID )
+    {
+      Scene.ClearScene();
+    } /* End of 'rt_cli::~rt_cli' function */
+
+    /* Print command line usage function.
+     * ARGUMENTS:
+     *   - program name:
+     *       const CHAR *ProgName;
+     * RETURNS: None.
+     */
+    VOID rt_cli::Usage( const CHAR *ProgName )
+    {
+      std::cout <<
+        "CGSG IP5 :: Ray Tracing :: headless renderer\n"
+        "Usage: " << ProgName << " [options]\n"
+        "  -w <width>        output image width (default 800)\n"
+        "  -h <height>       output image height (default 600)\n"
+        "  -spp <count>      samples per pixel, rounded to square grid (default 4)\n"
+        "  -t <count>        render threads count (default all hardware threads)\n"
+        "  -sampler <mode>   pixel samples: grid, random, stratified, halton, sobol,\n"
+        "                    bluenoise (default grid)\n"
+        "  -seed <number>    samples sequences seed (default 0)\n"
+        "  -procs <count>    render by worker processes count, -t is per process (default 1)\n"
+        "  -pin              pin worker processes to separate processors ranges\n"
+        "  -preview          render coarse to fine (1/8, 1/4, 1/2, full), report levels time\n"
+        "  -wavefront        trace rays by bounces in tile-wide streams (breadth-first)\n"
+        "  -denoise          filter rendered image by edge-aware denoiser\n"
+        "  -attenuation      attenuate lights by distance, skip lights whose contribution\n"
+        "                    is below cut off\n"
+        "  -lightcutoff <v>  attenuated light contribution cut off (default 1/512)\n"
+        "  -noshadowcache    do not test last shadow occluder first\n"
+        "  -texfilter <mode> texture filtering: nearest, bilinear, trilinear (default\n"
+        "                    trilinear, mip level is selected by ray footprint)\n"
+        "  -noraydiff        do not trace ray differentials (filtered textures use\n"
+        "                    full resolution level)\n"
+        "  -texcompress      store textures by 4x4 texels compressed blocks (8 times\n"
+        "                    less memory, lossy)\n"
+        "  -texfloat         store textures by float colors (4 times more memory, no\n"
+        "                    texels unpacking on lookup)\n"
+        "  -texsrgb          convert textures from sRGB to linear light colors\n"
+        "  -texlazy          decode model textures on first lookup, keep decoded ones\n"
+        "                    in cache (least recently used are evicted)\n"
+        "  -texbudget <mb>   lazy textures cache memory budget (default 256)\n"
+        "  -areaearly <k>    area light shadow samples after which fully lit or occluded\n"
+        "                    points stop sampling (default 4)\n"
+        "  -wavesort <mode>  wavefront queues sorting: none, octant, shape, all (default none)\n"
+        "  -maxdepth <n>     maximal ray recursion level (default 5)\n"
+        "  -roulette <d>,<t> terminate paths after d bounces by Russian roulette when\n"
+        "                    throughput is below t (default off)\n"
+        "  -scene <file>     scene description file\n"
+        "  -model <file>     add *.g3dm or *.obj model (may be repeated)\n"
+        "  -o <file>         output TGA file name (default out.tga)\n"
+        "  -relight <file>   keep primary hits (G-buffer), then render again from them\n"
+        "                    (relight pass) and store to file\n"
+        "  -move <n>,<x>,<y>,<z>  then translate shape number n and re-render only\n"
+        "                    affected (dirty) tiles\n"
+        "  -edit <file>      image file name for -move render (default edit.tga)\n"
+        "  -frames <count>   render animation frames by scene keys, output name gets\n"
+        "                    frame number ('%04d' format in name or '_0000' suffix)\n"
+        "  -texbench <file>  measure *.g3dm textures sampling speed for linear and\n"
+        "                    tiled texels layout (no render)\n"
+        "  -mthcheck         compare math SIMD kernels with scalar ones and batch\n"
+        "                    transformations with per item ones on random data,\n"
+        "                    measure their speed (no render)\n"
+        "  -help             print this message\n";
+    } /* End of 'rt_cli::Usage' function */
+
+    /* Parse command line arguments function.
+     * ARGUMENTS:
+     *   - arguments count:
+     *       INT Argc;
+     *   - arguments array:
+     *       CHAR **Argv;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL rt_cli::ParseArgs( INT Argc, CHAR **Argv )
+    {
+      for (INT i = 1; i < Argc; i++)
+      {
+        std::string Opt = Argv[i];
+
+        if (Opt == "-help" || Opt == "--help" || Opt == "-?")
+        {
+          IsHelp = TRUE;
+          continue;
+        }
+        if (Opt == "-pin")
+        {
+          IsPin = TRUE;
+          continue;
+        }
+        if (Opt == "-preview")
+        {
+          IsPreview = TRUE;
+          continue;
+        }
+        if (Opt == "-wavefront")
+        {
+          IsWavefront = TRUE;
+          continue;
+        }
+        if (Opt == "-denoise")
+        {
+          IsDenoise = TRUE;
+          continue;
+        }
+        if (Opt == "-attenuation")
+        {
+          IsAttenuation = TRUE;
+          continue;
+        }
+        if (Opt == "-noshadowcache")
+        {
+          IsShadowCache = FALSE;
+          continue;
+        }
+        if (Opt == "-noraydiff")
+        {
+          IsRayDiff = FALSE;
+          continue;
+        }
+        if (Opt == "-texcompress")
+        {
+          TexFormat = texture::BC1;
+          continue;
+        }
+        if (Opt == "-texfloat")
+        {
+          TexFormat = texture::RGB32F;
+          continue;
+        }
+        if (Opt == "-texsrgb")
+        {
+          IsTexSRGB = TRUE;
+          continue;
+        }
+        if (Opt == "-texlazy")
+        {
+          IsTexLazy = TRUE;
+          continue;
+        }
+        if (Opt == "-mthcheck")
+        {
+          IsMthCheck = TRUE;
+          continue;
+        }
+
+        // All other options have value
+        if (i + 1 >= Argc)
+        {
+          std::cerr << "Missing value for option '" << Opt << "'" << std::endl;
+          return FALSE;
+        }
+        const CHAR *Val = Argv[++i];
+
+        if (Opt == "-w")
+          W = atoi(Val);
+        else if (Opt == "-h")
+          H = atoi(Val);
+        else if (Opt == "-spp")
+          SamplesPerPixel = atoi(Val);
+        else if (Opt == "-t")
+          ThreadsCount = atoi(Val);
+        else if (Opt == "-procs")
+          ProcsCount = atoi(Val);
+        else if (Opt == "-frames")
+          FramesCount = atoi(Val);
+        else if (Opt == "-lightcutoff")
+          LightCutoff = atof(Val);
+        else if (Opt == "-texfilter")
+        {
+          std::string Mode = Val;
+
+          if (Mode == "nearest")
+            TexFilter = texture::NEAREST;
+          else if (Mode == "bilinear")
+            TexFilter = texture::BILINEAR;
+          else if (Mode == "trilinear")
+            TexFilter = texture::TRILINEAR;
+          else
+          {
+            std::cerr << "Unknown texture filter '" << Val << "'" << std::endl;
+            return FALSE;
+          }
+        }
+        else if (Opt == "-texbudget")
+          TexBudget = atoi(Val);
+        else if (Opt == "-texbench")
+          TexBenchFileName = Val;
+        else if (Opt == "-areaearly")
+          AreaEarlySamples = atoi(Val);
+        else if (Opt == "-maxdepth")
+          MaxDepth = atoi(Val);
+        else if (Opt == "-roulette")
+        {
+          if (sscanf(Val, "%d,%lf", &RouletteDepth, &RouletteThreshold) < 1 || RouletteDepth < 0 ||
+              RouletteThreshold <= 0)
+          {
+            std::cerr << "Invalid Russian roulette parameters '" << Val << "'" << std::endl;
+            return FALSE;
+          }
+        }
+        else if (Opt == "-sampler")
+        {
+          if (!sampler::ModeByName(Val, &SamplerMode))
+          {
+            std::cerr << "Unknown sampler '" << Val << "'" << std::endl;
+            return FALSE;
+          }
+        }
+        else if (Opt == "-seed")
+          Seed = (DWORD)strtoul(Val, nullptr, 0);
+        else if (Opt == "-wavesort")
+        {
+          std::string Mode = Val;
+
+          if (Mode == "none")
+            WaveSort = scene::WAVE_SORT_NONE;
+          else if (Mode == "octant")
+            WaveSort = scene::WAVE_SORT_OCTANT;
+          else if (Mode == "shape")
+            WaveSort = scene::WAVE_SORT_SHAPE;
+          else if (Mode == "all")
+            WaveSort = scene::WAVE_SORT_OCTANT | scene::WAVE_SORT_SHAPE;
+          else
+          {
+            std::cerr << "Unknown wavefront sorting '" << Val << "'" << std::endl;
+            return FALSE;
+          }
+        }
+        else if (Opt == "-scene")
+          SceneFileName = Val;
+        else if (Opt == "-model")
+          ModelFileNames.push_back(Val);
+        else if (Opt == "-o")
+          OutFileName = Val;
+        else if (Opt == "-relight")
+          RelightFileName = Val;
+        else if (Opt == "-move")
+        {
+          DBL X, Y, Z;
+
+          if (sscanf(Val, "%d,%lf,%lf,%lf", &MoveShape, &X, &Y, &Z) != 4 || MoveShape < 0)
+          {
+            std::cerr << "Invalid shape move '" << Val << "'" << std::endl;
+            return FALSE;
+          }
+          MoveShift = vec3(X, Y, Z);
+        }
+        else if (Opt == "-edit")
+          EditFileName = Val;
+        else
+        {
+          std::cerr << "Unknown option '" << Opt << "'" << std::endl;
+          return FALSE;
+        }
+      }
+
+      if (W <= 0 || H <= 0 || W > 0xFFFF || H > 0xFFFF)
+      {
+        std::cerr << "Invalid image size " << W << "x" << H << std::endl;
+        return FALSE;
+      }
+      if (ProcsCount <= 0)
+      {
+        std::cerr << "Invalid worker processes count " << ProcsCount << std::endl;
+        return FALSE;
+      }
+      if (FramesCount <= 0)
+      {
+        std::cerr << "Invalid animation frames count " << FramesCount << std::endl;
+        return FALSE;
+      }
+      if (FramesCount > 1 && FrameFileName(OutFileName, 0).empty())
+      {
+        std::cerr << "Invalid frames file name '" << OutFileName <<
+          "' (only one '%d' or '%0Nd' and '%%' are allowed)" << std::endl;
+        return FALSE;
+      }
+      if (!RelightFileName.empty() && (FramesCount > 1 || ProcsCount > 1 || IsPreview))
+      {
+        std::cerr << "Relight pass is supported only for single image single process render" << std::endl;
+        return FALSE;
+      }
+      if (MoveShape >= 0 && (FramesCount > 1 || ProcsCount > 1 || IsPreview || !RelightFileName.empty()))
+      {
+        std::cerr << "Shape move is supported only for single image single process render" << std::endl;
+        return FALSE;
+      }
+      if (IsDenoise && ProcsCount > 1)
+      {
+        std::cerr << "Denoising is not supported for worker processes render" << std::endl;
+        return FALSE;
+      }
+      if (MaxDepth < 0)
+      {
+        std::cerr << "Invalid maximal recursion level " << MaxDepth << std::endl;
+        return FALSE;
+      }
+      if (FramesCount > 1 && ProcsCount > 1)
+      {
+        std::cerr << "Animation rendering by worker processes is not supported" << std::endl;
+        return FALSE;
+      }
+      if (SamplesPerPixel <= 0)
+      {
+        std::cerr << "Invalid samples per pixel count " << SamplesPerPixel << std::endl;
+        return FALSE;
+      }
+      return TRUE;
+    } /* End of 'rt_cli::ParseArgs' function */
+
+    /* Build default scene function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID rt_cli::DefaultScene( VOID )
+    {
+      Camera.SetLocAtUp(vec3(3), vec3(0, 0, 0));
+
+      shape *S = new plane(vec3(0, 1, 0), vec3(0, -1, 0));
+      S->SetUsingModeFlag(true);
+      Scene << S;
+
+      Scene << new box(vec3(-1, 0, 0), vec3(-2, 1, 1), "Gold");
+      Scene << new lights::point_light(0.7, 0.1, 0.1, vec3(1, 1, 1), vec3(3.5, 5, 5));
+    } /* End of 'rt_cli::DefaultScene' function */
+
+    /* Load scene description file function.
+     * ARGUMENTS:
+     *   - scene file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL rt_cli::LoadScene( const std::string &FileName )
+    {
+      std::ifstream F(FileName);
+
+      if (!F.is_open())
+      {
+        std::cerr << "Cannot open scene file '" << FileName << "'" << std::endl;
+        return FALSE;
+      }
+
+      auto ReadVec =
+        []( std::istringstream &Str ) -> vec3
+        {
+          vec3 V;
+
+          Str >> V.X >> V.Y >> V.Z;
+          return V;
+        };
+      auto ReadRest =
+        []( std::istringstream &Str, const CHAR *Default ) -> std::string
+        {
+          std::string Rest;
+
+          if (Str.fail())
+            return Default;
+          std::getline(Str >> std::ws, Rest);
+          if (Rest.empty())
+            Str.clear(Str.rdstate() & ~std::ios::failbit);
+          return Rest.empty() ? Default : Rest;
+        };
+
+      std::string Line;
+      INT LineNo = 0;
+      shape *Last = nullptr;
+
+      while (std::getline(F, Line))
+      {
+        LineNo++;
+        if (auto Comment = Line.find('#'); Comment != std::string::npos)
+          Line.resize(Comment);
+
+        std::istringstream Str(Line);
+        std::string Cmd;
+
+        if (!(Str >> Cmd))
+          continue;
+
+        if (Cmd == "camera")
+        {
+          vec3 L = ReadVec(Str), A = ReadVec(Str), U = ReadVec(Str);
+
+          if (Str.fail())
+            U = vec3(0, 1, 0), Str.clear();
+          Camera.SetLocAtUp(L, A, U);
+        }
+        else if (Cmd == "camkey")
+        {
+          camera_key K {0};
+
+          Str >> K.Time;
+          K.Loc = ReadVec(Str);
+          K.At = ReadVec(Str);
+          K.Up = ReadVec(Str);
+          if (Str.fail())
+            K.Up = vec3(0, 1, 0), Str.clear();
+          Anim.CameraKeys.AddKey(K);
+        }
+        else if (Cmd == "key" && Last != nullptr)
+        {
+          transform_key K {0, vec3(0), vec3(0), vec3(1)};
+
+          Str >> K.Time;
+          K.Pos = ReadVec(Str);
+          if (!Str.fail())
+          {
+            vec3 A = ReadVec(Str);
+
+            if (!Str.fail())
+            {
+              K.Angles = A;
+              A = ReadVec(Str);
+              if (!Str.fail())
+                K.Scale = A;
+            }
+            if (!Str.fail() || Str.eof())
+              Str.clear();
+          }
+          if (!Str.fail())
+            Anim.Track(Last).Keys.AddKey(K);
+        }
+        else if (Cmd == "background")
+          Scene.BackgroundColor = ReadVec(Str);
+        else if (Cmd == "ambient")
+          Scene.AmbientColor = ReadVec(Str);
+        else if (Cmd == "fog")
+        {
+          std::string Mode;
+
+          Str >> Mode;
+          vec3 C = ReadVec(Str);
+
+          if (Mode == "linear")
+          {
+            Str >> Scene.FogStart >> Scene.FogEnd;
+            Scene.FogMode = scene::FOG_LINEAR;
+          }
+          else if (Mode == "exp" || Mode == "height")
+          {
+            Str >> Scene.FogDensity;
+            if (Mode == "height")
+              Str >> Scene.FogHeight >> Scene.FogFalloff;
+            if (!Str.fail() && !(Str >> Scene.FogStart))
+              Str.clear(), Scene.FogStart = 0;
+            Scene.FogMode = Mode == "exp" ? scene::FOG_EXP : scene::FOG_HEIGHT;
+          }
+          else
+            Scene.FogMode = scene::FOG_NONE;
+          Scene.FogColor = C;
+        }
+        else if (Cmd == "light")
+        {
+          DBL Cc = 1, Cl = 0, Cq = 0;
+
+          Str >> Cc >> Cl >> Cq;
+          vec3 C = ReadVec(Str), P = ReadVec(Str);
+          Scene << new lights::point_light(Cc, Cl, Cq, C, P);
+        }
+        else if (Cmd == "spherelight" || Cmd == "rectlight")
+        {
+          DBL Cc = 1, Cl = 0, Cq = 0, R = 1;
+          INT Side = 4;
+          vec3 E1, E2;
+
+          Str >> Cc >> Cl >> Cq;
+          vec3 C = ReadVec(Str), P = ReadVec(Str);
+
+          if (Cmd == "spherelight")
+            Str >> R;
+          else
+            E1 = ReadVec(Str), E2 = ReadVec(Str);
+          if (!Str.fail() && !(Str >> Side))
+            Str.clear(), Side = 4;
+          if (!Str.fail() && Cmd == "spherelight")
+            Scene << new lights::sphere_light(Cc, Cl, Cq, C, P, R, (std::max)(Side, 1));
+          else if (!Str.fail())
+            Scene << new lights::rect_light(Cc, Cl, Cq, C, P, E1, E2, (std::max)(Side, 1));
+        }
+        else if (Cmd == "plane")
+        {
+          vec3 N = ReadVec(Str), P = ReadVec(Str);
+          std::string Tex = ReadRest(Str, "");
+
+          if (!Str.fail())
+          {
+            Last = Tex.empty() ? new plane(N, P) : new plane(N, P, Tex);
+            Last->SetUsingModeFlag(true);
+            Scene << Last;
+          }
+        }
+        else if (Cmd == "sphere")
+        {
+          vec3 C = ReadVec(Str);
+          DBL R = 1;
+
+          Str >> R;
+          std::string Mtl = ReadRest(Str, "Gold");
+          Scene << (Last = new sphere(C, R, Mtl.c_str()));
+        }
+        else if (Cmd == "box")
+        {
+          vec3 P1 = ReadVec(Str), P2 = ReadVec(Str);
+          std::string Mtl = ReadRest(Str, "Gold");
+
+          Scene << (Last = new box(P1, P2, Mtl.c_str()));
+        }
+        else if (Cmd == "tor")
+        {
+          vec3 C = ReadVec(Str);
+          DBL R1 = 2, R2 = 1;
+
+          Str >> R1 >> R2;
+          Scene << (Last = new tor(C, R1, R2));
+        }
+        else if (Cmd == "g3dm")
+          Scene << (Last = new g3dm(ReadRest(Str, "")));
+        else if (Cmd == "obj")
+          Scene << (Last = new objmodel(ReadRest(Str, "")));
+        else if (Last != nullptr &&
+                 (Cmd == "mode" || Cmd == "translate" || Cmd == "scale" ||
+                  Cmd == "rotatex" || Cmd == "rotatey" || Cmd == "rotatez"))
+        {
+          if (Cmd == "mode")
+          {
+            INT Flag = 1;
+
+            Str >> Flag;
+            Last->SetUsingModeFlag(Flag != 0);
+            continue;
+          }
+
+          matr M = matr::Identity();
+          DBL Angle = 0;
+
+          if (Cmd == "translate")
+            M = matr::Translate(ReadVec(Str));
+          else if (Cmd == "scale")
+            M = matr::Scale(ReadVec(Str));
+          else
+          {
+            Str >> Angle;
+            if (Cmd == "rotatex")
+              M = matr::RotateX(Angle);
+            else if (Cmd == "rotatey")
+              M = matr::RotateY(Angle);
+            else
+              M = matr::RotateZ(Angle);
+          }
+          Last->SetMatr(Last->GetMatr() * M);
+        }
+        else
+        {
+          std::cerr << FileName << "(" << LineNo << "): unknown command '" << Cmd << "'" << std::endl;
+          return FALSE;
+        }
+
+        if (Str.fail())
+        {
+          std::cerr << FileName << "(" << LineNo << "): invalid '" << Cmd << "' arguments" << std::endl;
+          return FALSE;
+        }
+      }
+      return TRUE;
+    } /* End of 'rt_cli::LoadScene' function */
+
+    /* Render scene and store image function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) process exit code.
+     */
+    INT rt_cli::Run( VOID )
+    {
+      // Textures are compressed while loading
+      texture::DefaultFormat = TexFormat;
+      texture::SetSRGB(IsTexSRGB);
+      TexManager.IsLazy = IsTexLazy;
+      TexCache.Budget = (UINT_PTR)TexBudget << 20;
+      if (IsMthCheck)
+        return MthCheck();
+      if (!TexBenchFileName.empty())
+        return TexBench();
+      if (!SceneFileName.empty())
+      {
+        if (!LoadScene(SceneFileName))
+          return 1;
+      }
+      else if (ModelFileNames.empty())
+        DefaultScene();
+      else
+      {
+        Camera.SetLocAtUp(vec3(3), vec3(0, 0, 0));
+        Scene << new lights::point_light(0.7, 0.1, 0.1, vec3(1, 1, 1), vec3(3.5, 5, 5));
+      }
+
+      for (auto &Name : ModelFileNames)
+      {
+        shape *S;
+
+        if (Name.size() > 4 && Name.substr(Name.size() - 4) == ".obj")
+          S = new objmodel(Name);
+        else
+        {
+          S = new g3dm(Name);
+          S->SetMatr(matr::RotateX(-90));
+        }
+        Scene << S;
+      }
+
+      // Shapes transformations from scene file are base for animation keys
+      Anim.Bind();
+
+      Scene.ThreadsCount = ThreadsCount;
+      Scene.Sampler.Mode = SamplerMode;
+      Scene.Sampler.Seed = Seed;
+      Scene.IsWavefront = IsWavefront;
+      Scene.WaveSort = WaveSort;
+      Scene.IsGBuffer = !RelightFileName.empty();
+      Scene.IsTrackTiles = MoveShape >= 0;
+      Scene.MaxRecLevel = MaxDepth;
+      Scene.IsDenoise = IsDenoise;
+      Scene.IsAttenuation = IsAttenuation;
+      Scene.LightCutoff = LightCutoff;
+      Scene.IsShadowCache = IsShadowCache;
+      Scene.AreaEarlySamples = AreaEarlySamples;
+      texture::Filter = TexFilter;
+      Scene.IsRayDiff = IsRayDiff;
+      Scene.IsRoulette = RouletteDepth >= 0;
+      if (Scene.IsRoulette)
+        Scene.RouletteDepth = RouletteDepth, Scene.RouletteThreshold = RouletteThreshold;
+      Scene.SampleGrid = (INT)std::lround(std::sqrt((DBL)SamplesPerPixel));
+      if (Scene.SampleGrid < 1)
+        Scene.SampleGrid = 1;
+      if (Scene.SampleGrid * Scene.SampleGrid != SamplesPerPixel)
+        std::cout << "Samples per pixel rounded to " << Scene.SampleGrid * Scene.SampleGrid << std::endl;
+
+      Frame.Resize(W, H);
+      Camera.Resize(W, H);
+      if (FramesCount > 1)
+        return RunAnimation();
+      if (!Anim.IsEmpty())
+      {
+        REAL T0, T1;
+
+        Anim.GetTimeRange(&T0, &T1);
+        Anim.Apply(T0, Camera);
+      }
+
+      std::cout << "Render " << W << "x" << H << ", " <<
+        Scene.SampleGrid * Scene.SampleGrid << " spp, " <<
+        Scene.Shapes.size() << " shapes, " << Scene.Lights.size() << " lights" << std::endl;
+      if (!TexManager.Stock.empty())
+        std::cout << "Textures: " << TexManager.Stock.size() << ", " << std::fixed << std::setprecision(2) <<
+          TexManager.MemorySize() / 1048576.0 << " MB" << std::defaultfloat << std::endl;
+
+      auto Start = std::chrono::steady_clock::now();
+      Scene.IsRenderActive = TRUE;
+      Scene.IsReadyToFinish = FALSE;
+      BOOL IsOk = TRUE;
+      if (ProcsCount > 1)
+        IsOk = RenderProcs();
+      else if (IsPreview)
+        Scene.RenderProgressive(Camera, Frame,
+          [&]( INT Block )
+          {
+            std::cout << "Level 1/" << Block << ": " << std::fixed <<
+              std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count() << std::endl;
+          });
+      else
+      {
+        render_job Job(Scene, Camera, Frame);
+
+        while (!Job.Wait(1))
+          std::cout << std::fixed << std::setprecision(1) << Job.Progress() << "%, ETA " <<
+            (Job.ETA() < 0 ? 0 : Job.ETA()) << " s    \r" << std::flush;
+        std::cout << std::setprecision(6);
+        IsOk = Job.Future().get() != nullptr;
+      }
+      Scene.IsRenderActive = FALSE;
+      Scene.IsReadyToFinish = TRUE;
+      DBL tt = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+      INT Seconds = (INT)tt;
+
+      if (!IsOk)
+        return 1;
+
+      std::cout <<
+        std::fixed << tt <<
+        " :: " << std::setfill('0') << std::setw(2) <<
+                                       Seconds / 60 / 60 <<
+        ":" << std::setfill('0') << std::setw(2) <<
+                                       Seconds / 60 % 60 <<
+        ":" << std::setfill('0') << std::setw(2) <<
+                                       Seconds % 60 << std::endl;
+      if (ProcsCount == 1)
+        std::cout << "Paths terminated: " << Scene.KilledByDepth << " by depth, " <<
+          Scene.KilledByThroughput << " by throughput, " << Scene.KilledByRoulette << " by roulette" << std::endl <<
+          "Shadow cache: " << Scene.ShadowCacheHits << " hits of " << Scene.ShadowCacheTests << " tests (" <<
+          std::setprecision(1) << Scene.ShadowCacheHitRate() * 100 << "%)" << std::setprecision(6) << std::endl <<
+          "Area lights: " << Scene.AreaShadowRays << " shadow rays, " << Scene.AreaShadowSkipped <<
+          " skipped by early out" << std::endl;
+      if (ProcsCount == 1 && IsTexLazy)
+        std::cout << "Texture cache: " << TexCache.Hits << " hits, " << TexCache.Misses << " misses, " <<
+          TexCache.Evictions << " evictions, " << std::setprecision(2) << TexCache.MemorySize() / 1048576.0 <<
+          " MB decoded" << std::setprecision(6) << std::endl;
+      if (IsDenoise)
+      {
+        auto DenoiseStart = std::chrono::steady_clock::now();
+
+        if (!Scene.Denoise(Frame))
+        {
+          std::cerr << "Denoising failed" << std::endl;
+          return 1;
+        }
+        std::cout << "Denoise: " << std::fixed <<
+          std::chrono::duration<DBL>(std::chrono::steady_clock::now() - DenoiseStart).count() << " s" << std::endl;
+      }
+
+      if (!Frame.SaveTGA(OutFileName, "CGSG forever!!!",
+                         {Seconds / 60 / 60, Seconds / 60 % 60, Seconds % 60}))
+      {
+        std::cerr << "Cannot store image to '" << OutFileName << "'" << std::endl;
+        return 1;
+      }
+      std::cout << "Image stored to '" << OutFileName << "'" << std::endl;
+
+      if (!RelightFileName.empty())
+      {
+        Start = std::chrono::steady_clock::now();
+        if (!Scene.Relight(Camera, Frame))
+        {
+          std::cerr << "Relight pass failed" << std::endl;
+          return 1;
+        }
+        if (IsDenoise)
+          Scene.Denoise(Frame);
+        tt = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+        std::cout << "Relight pass: " << std::fixed << tt << " s, G-buffer " <<
+          Scene.GBuffer.size() * sizeof(intr) / 1048576 << " MB" << std::endl;
+        if (!Frame.SaveTGA(RelightFileName, "CGSG forever!!!"))
+        {
+          std::cerr << "Cannot store image to '" << RelightFileName << "'" << std::endl;
+          return 1;
+        }
+        std::cout << "Image stored to '" << RelightFileName << "'" << std::endl;
+      }
+
+      if (MoveShape >= 0)
+      {
+        if (MoveShape >= (INT)Scene.Shapes.size())
+        {
+          std::cerr << "No shape number " << MoveShape << " to move" << std::endl;
+          return 1;
+        }
+        shape *Shp = Scene.Shapes[MoveShape];
+
+        Start = std::chrono::steady_clock::now();
+        Shp->SetMatr(Shp->GetMatr() * matr::Translate(MoveShift));
+        std::vector<INT> Dirty = Scene.DirtyTiles(Camera, Shp);
+        if (!Scene.RenderTileList(Camera, Frame, Dirty))
+          return 1;
+        if (IsDenoise)
+          Scene.Denoise(Frame);
+        tt = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+        std::cout << "Incremental render: " << Dirty.size() << " of " <<
+          tile_grid(W, H, Scene.TileSize).Count() << " tiles, " << std::fixed << tt << " s" << std::endl;
+        if (!Frame.SaveTGA(EditFileName, "CGSG forever!!!"))
+        {
+          std::cerr << "Cannot store image to '" << EditFileName << "'" << std::endl;
+          return 1;
+        }
+        std::cout << "Image stored to '" << EditFileName << "'" << std::endl;
+      }
+      return 0;
+    } /* End of 'rt_cli::Run' function */
+
+    /* Build animation frame image file name function.
+     * ARGUMENTS:
+     *   - file name pattern (with printf-like integer format or not):
+     *       const std::string &Pattern;
+     *   - frame number:
+     *       INT No;
+     * RETURNS:
+     *   (std::string) file name or empty string if pattern format is invalid.
+     */
+    std::string rt_cli::FrameFileName( const std::string &Pattern, INT No )
+    {
+      CHAR Buf[32];
+
+      if (Pattern.find('%') != std::string::npos)
+      {
+        // Pattern is not passed as format: only one '%d'/'%0Nd' and '%%' are allowed
+        std::string Name;
+        INT Convs = 0;
+
+        for (UINT_PTR i = 0; i < Pattern.size(); i++)
+        {
+          if (Pattern[i] != '%')
+          {
+            Name += Pattern[i];
+            continue;
+          }
+          if (++i < Pattern.size() && Pattern[i] == '%')
+          {
+            Name += '%';
+            continue;
+          }
+
+          BOOL IsZero = i < Pattern.size() && Pattern[i] == '0';
+          INT Width = 0;
+
+          if (IsZero)
+            i++;
+          while (i < Pattern.size() && Pattern[i] >= '0' && Pattern[i] <= '9' && Width < 100)
+            Width = Width * 10 + Pattern[i++] - '0';
+          if (i >= Pattern.size() || Pattern[i] != 'd' || Width >= 100 || ++Convs > 1)
+            return "";
+          snprintf(Buf, sizeof(Buf), IsZero ? "%0*d" : "%*d", Width, No);
+          Name += Buf;
+        }
+        return Convs == 1 ? Name : "";
+      }
+
+      UINT_PTR Dot = Pattern.rfind('.'), Slash = Pattern.find_last_of("/\\");
+
+      if (Dot == std::string::npos || (Slash != std::string::npos && Dot < Slash))
+        Dot = Pattern.size();
+      snprintf(Buf, sizeof(Buf), "_%04d", No);
+      return Pattern.substr(0, Dot) + Buf + Pattern.substr(Dot);
+    } /* End of 'rt_cli::FrameFileName' function */
+
+    /* Render animation frames and store images function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) process exit code.
+     */
+    INT rt_cli::RunAnimation( VOID )
+    {
+      REAL T0, T1;
+
+      if (Anim.IsEmpty())
+        std::cout << "Scene has no animation keys, all frames are the same" << std::endl;
+      Anim.GetTimeRange(&T0, &T1);
+
+      std::cout << "Render " << FramesCount << " frames " << W << "x" << H << ", " <<
+        Scene.SampleGrid * Scene.SampleGrid << " spp, " <<
+        Scene.Shapes.size() << " shapes, " << Scene.Lights.size() << " lights, time " <<
+        T0 << ".." << T1 << std::endl;
+
+      // Frame is stored while next one renders to other frame
+      frame BackFrame;
+      frame *Frames[2] {&Frame, &BackFrame};
+      std::future<BOOL> Stores[2];
+      BOOL IsOk = TRUE;
+
+      BackFrame.Resize(W, H);
+      auto Start = std::chrono::steady_clock::now();
+      Scene.IsRenderActive = TRUE;
+      Scene.IsReadyToFinish = FALSE;
+      for (INT i = 0; i < FramesCount && IsOk; i++)
+      {
+        frame &Frm = *Frames[i % 2];
+        std::future<BOOL> &Store = Stores[i % 2];
+
+        if (Store.valid() && !Store.get())
+          IsOk = FALSE;
+
+        auto FrameStart = std::chrono::steady_clock::now();
+        Anim.Apply(T0 + (T1 - T0) * i / (FramesCount - 1), Camera);
+        Scene.Sampler.Seed = Seed + i;
+        Scene.Render(Camera, Frm);
+        if (IsDenoise)
+          Scene.Denoise(Frm);
+        DBL tt = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - FrameStart).count();
+        INT Seconds = (INT)tt;
+        std::string Name = FrameFileName(OutFileName, i);
+
+        std::cout << "Frame " << i << ": " << std::fixed << tt << " -> '" << Name << "'" << std::endl;
+        Store = std::async(std::launch::async,
+          [&Frm, Name, Seconds]( VOID ) -> BOOL
+          {
+            if (Frm.SaveTGA(Name, "CGSG forever!!!",
+                            {Seconds / 60 / 60, Seconds / 60 % 60, Seconds % 60}))
+              return TRUE;
+            std::cerr << "Cannot store image to '" << Name << "'" << std::endl;
+            return FALSE;
+          });
+      }
+      for (auto &Store : Stores)
+        if (Store.valid() && !Store.get())
+          IsOk = FALSE;
+      Scene.IsRenderActive = FALSE;
+      Scene.IsReadyToFinish = TRUE;
+
+      DBL tt = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+
+      std::cout << "Animation " << (IsOk ? "done" : "failed") << ": " << std::fixed << tt <<
+        " s, " << tt / FramesCount << " s per frame" << std::endl;
+      return IsOk ? 0 : 1;
+    } /* End of 'rt_cli::RunAnimation' function */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+/* END OF 'rt_cli.cpp' FILE */
@@ -0,0 +1,174 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        rt_cli.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's headless command line renderer header file.
+ * NOTE:        None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __rt_cli_h_
+#define __rt_cli_h_
+
+#include <string>
+#include <vector>
+
+#include "frame.h"
+#include "rt_scene.h"
+#include "anim.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* RayTracing headless (batch) renderer class */
+    class rt_cli
+    {
+    public:
+      frame Frame;
+      camera Camera;
+      scene Scene;
+      animation Anim;
+
+      //-----------------------------
+      // Command line options:
+      //-----------------------------
+      INT
+        W = 800, H = 600,                     // Output image size
+        SamplesPerPixel = 4,                  // Samples per pixel
+        ThreadsCount = 0,                     // Render threads count (0 - all hardware threads)
+        ProcsCount = 1,                       // Render worker processes count
+        FramesCount = 1,                      // Animation frames count
+        MaxDepth = 5,                         // Maximal recurse level
+        RouletteDepth = -1;                   // Bounces before Russian roulette (-1 - no roulette)
+      DBL RouletteThreshold = 0.25;           // Russian roulette throughput threshold
+      std::string
+        SceneFileName,                        // Scene description file name
+        OutFileName = "out.tga",              // Output image file name
+        RelightFileName,                      // Relight pass (from G-buffer) image file name
+        EditFileName = "edit.tga",            // Incremental (after shape move) render image file name
+        TexBenchFileName;                     // Textures sampling benchmark model (*.g3dm) file name
+      std::vector<std::string>
+        ModelFileNames;                       // Model (*.g3dm, *.obj) file names
+      BOOL IsHelp = FALSE;                    // Print usage flag
+      BOOL IsPin = FALSE;                     // Pin worker processes to processors flag
+      BOOL IsPreview = FALSE;                 // Coarse to fine render flag
+      BOOL IsWavefront = FALSE;               // Wavefront tracing flag
+      BOOL IsDenoise = FALSE;                 // Denoise rendered image flag
+      BOOL IsAttenuation = FALSE;             // Lights attenuation (and culling) flag
+      DBL LightCutoff = 1.0 / 512;            // Attenuated light contribution cut off
+      BOOL IsShadowCache = TRUE;              // Shadow occluders cache flag
+      INT AreaEarlySamples = 4;               // Area lights early out samples count
+      texture::FILTER TexFilter = texture::TRILINEAR; // Textures filtering mode
+      texture::FORMAT TexFormat = texture::BGRA8; // Textures storage format
+      BOOL IsTexSRGB = FALSE;                 // Textures are sRGB encoded (converted to linear light) flag
+      BOOL IsTexLazy = FALSE;                 // Decode model textures on first lookup flag
+      INT TexBudget = 256;                    // Decoded lazy textures memory budget in megabytes
+      BOOL IsRayDiff = TRUE;                  // Ray differentials tracing flag
+      BOOL IsMthCheck = FALSE;                // Math SIMD kernels check flag
+      INT WaveSort = scene::WAVE_SORT_NONE;   // Wavefront queues sorting flags
+      sampler::MODE SamplerMode = sampler::GRID; // Samples generation mode
+      DWORD Seed = 0;                         // Samples sequences seed
+      INT MoveShape = -1;                     // Moved shape number (-1 - no incremental render)
+      vec3 MoveShift;                         // Moved shape translation
+
+      /* Default constructor */
+      rt_cli( VOID );
+
+      /* Default destructor */
+      ~rt_cli( VOID );
+
+      /* Parse command line arguments function.
+       * ARGUMENTS:
+       *   - arguments count:
+       *       INT Argc;
+       *   - arguments array:
+       *       CHAR **Argv;
+       * RETURNS:
+       *   (BOOL) TRUE if success, FALSE otherwise.
+       */
+      BOOL ParseArgs( INT Argc, CHAR **Argv );
+
+      /* Print command line usage function.
+       * ARGUMENTS:
+       *   - program name:
+       *       const CHAR *ProgName;
+       * RETURNS: None.
+       */
+      static VOID Usage( const CHAR *ProgName );
+
+      /* Load scene description file function.
+       * ARGUMENTS:
+       *   - scene file name:
+       *       const std::string &FileName;
+       * RETURNS:
+       *   (BOOL) TRUE if success, FALSE otherwise.
+       */
+      BOOL LoadScene( const std::string &FileName );
+
+      /* Build default scene function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID DefaultScene( VOID );
+
+      /* Render scene by several worker processes function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if success, FALSE otherwise.
+       */
+      BOOL RenderProcs( VOID );
+
+      /* Build animation frame image file name function.
+       * ARGUMENTS:
+       *   - file name pattern (with printf-like integer format or not):
+       *       const std::string &Pattern;
+       *   - frame number:
+       *       INT No;
+       * RETURNS:
+       *   (std::string) file name or empty string if pattern format is invalid.
+       */
+      static std::string FrameFileName( const std::string &Pattern, INT No );
+
+      /* Render animation frames and store images function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) process exit code.
+       */
+      INT RunAnimation( VOID );
+
+      /* Run textures sampling benchmark function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) process exit code.
+       */
+      INT TexBench( VOID );
+
+      /* Check math SIMD kernels by scalar ones function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) process exit code.
+       */
+      INT MthCheck( VOID );
+
+      /* Render scene and store image function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) process exit code.
+       */
+      INT Run( VOID );
+    }; /* End of 'rt_cli' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__rt_cli_h_
+
+/* END OF 'rt_cli.h' FILE */
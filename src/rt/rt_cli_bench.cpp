@@ -0,0 +1,407 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        rt_cli_bench.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's headless renderer benchmarks file.
+ * NOTE:        Texture benchmark samples every texture of g3dm file by
+ *              screen-like walks (one texel step per sample, rows of
+ *              walk are rotated by 0, 45 and 90 degrees to texture
+ *              rows) with full resolution bilinear filtering, for
+ *              linear and tiled texels layout, float colors and
+ *              compressed blocks storage. Textures are loaded lazily
+ *              and decoded again for every storage.
+ *              Math check runs vector and matrix SIMD kernels and their
+ *              scalar versions on the same random data, results must be
+ *              equal bit to bit (kernels keep scalar operations order).
+ *              Then batch (structure of arrays) points, vectors, normals
+ *              and rays transformations are compared with per item ones.
+ *              Double and float kernels are checked in both builds.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "pirt.h"
+#include "rt_cli.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Sample texture by rotated walk function.
+     * ARGUMENTS:
+     *   - texture:
+     *       const texture &Tex;
+     *   - walk rows direction angle (in degrees):
+     *       DBL Angle;
+     *   - samples count:
+     *       INT Count;
+     *   - sum of sampled colors (keeps samples from optimization):
+     *       vec3 *Sum;
+     * RETURNS:
+     *   (DBL) samples time in seconds.
+     */
+    static DBL TexWalk( const texture &Tex, DBL Angle, INT Count, vec3 *Sum )
+    {
+      const INT Side = 1024;
+      DBL
+        a = Angle * PI / 180,
+        du = cos(a) / Tex.GetW(), dv = sin(a) / Tex.GetH(),
+        ru = -sin(a) / Tex.GetW(), rv = cos(a) / Tex.GetH();
+      vec3 S;
+      auto Start = std::chrono::steady_clock::now();
+
+      for (INT i = 0; i < Count; i++)
+      {
+        INT x = i % Side, y = i / Side % Side;
+        // Walk start is shifted every frame, so samples are not cached from previous frame
+        DBL t = 0.37 * (i / (Side * Side));
+
+        S += Tex.GetColor(vec2(t + x * du + y * ru, t + x * dv + y * rv), 0);
+      }
+      *Sum += S;
+      return std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+    } /* End of 'TexWalk' function */
+
+    /* Check and measure math kernel function.
+     * ARGUMENTS:
+     *   - kernel name:
+     *       const CHAR *Name;
+     *   - kernel result size (in numbers):
+     *       INT Size;
+     *   - SIMD and scalar kernels (results are stored by first argument):
+     *       SimdKernel Simd;
+     *       ScalarKernel Scalar;
+     *   - arguments (16 numbers for every call):
+     *       const std::vector<Type> &A, &B;
+     *   - sum of results (keeps calls from optimization):
+     *       DBL *Sum;
+     * RETURNS:
+     *   (BOOL) TRUE if results are equal, FALSE otherwise.
+     */
+    template<typename Type, typename SimdKernel, typename ScalarKernel>
+      static BOOL MthKernel( const CHAR *Name, INT Size, SimdKernel Simd, ScalarKernel Scalar,
+                             const std::vector<Type> &A, const std::vector<Type> &B, DBL *Sum )
+      {
+        const INT Rounds = 256;
+        INT Count = (INT)A.size() / 16;
+        DBL MaxDiff = 0, T[2];
+        BOOL IsEqual = TRUE;
+
+        for (INT i = 0; i < Count; i++)
+        {
+          Type R0[16] {}, R1[16] {};
+
+          Simd(R0, &A[i * 16], &B[i * 16]);
+          Scalar(R1, &A[i * 16], &B[i * 16]);
+          for (INT k = 0; k < Size; k++)
+          {
+            MaxDiff = (std::max)(MaxDiff, fabs((DBL)R0[k] - R1[k]));
+            if (R0[k] != R1[k])
+              IsEqual = FALSE;
+          }
+        }
+        for (INT Pass = 0; Pass < 2; Pass++)
+        {
+          auto Start = std::chrono::steady_clock::now();
+          Type R[16], S[16] {};
+
+          for (INT j = 0; j < Rounds; j++)
+            for (INT i = 0; i < Count; i++)
+            {
+              if (Pass == 0)
+                Simd(R, &A[i * 16], &B[i * 16]);
+              else
+                Scalar(R, &A[i * 16], &B[i * 16]);
+              // All components are summed (by separate sums), so no one is thrown away by optimizer
+              for (INT k = 0; k < Size; k++)
+                S[k] += R[k];
+            }
+          for (INT k = 0; k < Size; k++)
+            *Sum += S[k];
+          T[Pass] = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+        }
+        std::cout << "  " << std::left << std::setw(16) << Name << std::right <<
+          std::fixed << std::setprecision(1) << std::setw(8) << Rounds * Count / T[0] / 1e6 <<
+          " " << std::setw(8) << Rounds * Count / T[1] / 1e6 << std::defaultfloat <<
+          "  " << MaxDiff << (IsEqual ? "" : "  MISMATCH") << std::endl;
+        return IsEqual;
+      } /* End of 'MthKernel' function */
+
+    /* Check and measure math kernels of one component type function.
+     * ARGUMENTS:
+     *   - component type name:
+     *       const CHAR *TypeName;
+     *   - arguments (16 numbers for every call):
+     *       const std::vector<Type> &A, &B;
+     *   - sum of results (keeps calls from optimization):
+     *       DBL *Sum;
+     * RETURNS:
+     *   (BOOL) TRUE if results are equal, FALSE otherwise.
+     */
+    template<typename Type>
+      static BOOL MthKernels( const CHAR *TypeName, const std::vector<Type> &A, const std::vector<Type> &B, DBL *Sum )
+      {
+        namespace simd = mth::simd;
+        namespace scalar = mth::simd::scalar;
+        BOOL IsEqual = TRUE;
+
+        std::cout << "Math kernels (" << simd::Backend() << " backend, " << TypeName << "), Mcalls/s:" << std::endl;
+        std::cout << "  kernel              simd   scalar  max diff" << std::endl;
+        IsEqual &= MthKernel("dot3", 1,
+          []( Type *D, const Type *X, const Type *Y ){ *D = simd::Dot3(X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ *D = scalar::Dot3(X, Y); }, A, B, Sum);
+        IsEqual &= MthKernel("cross3", 3,
+          []( Type *D, const Type *X, const Type *Y ){ simd::Cross3(D, X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ scalar::Cross3(D, X, Y); }, A, B, Sum);
+        IsEqual &= MthKernel("normalize3", 3,
+          []( Type *D, const Type *X, const Type * ){ simd::Div3(D, X, std::sqrt(simd::Dot3(X, X))); },
+          []( Type *D, const Type *X, const Type * ){ scalar::Div3(D, X, std::sqrt(scalar::Dot3(X, X))); }, A, B, Sum);
+        IsEqual &= MthKernel("dot4", 1,
+          []( Type *D, const Type *X, const Type *Y ){ *D = simd::Dot4(X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ *D = scalar::Dot4(X, Y); }, A, B, Sum);
+        IsEqual &= MthKernel("matrmulmatr", 16,
+          []( Type *D, const Type *X, const Type *Y ){ simd::MatrMulMatr(D, X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ scalar::MatrMulMatr(D, X, Y); }, A, B, Sum);
+        IsEqual &= MthKernel("transformpoint", 3,
+          []( Type *D, const Type *X, const Type *Y ){ simd::TransformPoint(D, X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ scalar::TransformPoint(D, X, Y); }, A, B, Sum);
+        IsEqual &= MthKernel("transformvector", 3,
+          []( Type *D, const Type *X, const Type *Y ){ simd::TransformVector(D, X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ scalar::TransformVector(D, X, Y); }, A, B, Sum);
+        IsEqual &= MthKernel("transform4", 4,
+          []( Type *D, const Type *X, const Type *Y ){ simd::Transform4(D, X, Y); },
+          []( Type *D, const Type *X, const Type *Y ){ scalar::Transform4(D, X, Y); }, A, B, Sum);
+        return IsEqual;
+      } /* End of 'MthKernels' function */
+
+    /* Check and measure batch transformations of one component type function.
+     * ARGUMENTS:
+     *   - component type name:
+     *       const CHAR *TypeName;
+     *   - points and directions components (3 numbers for every item):
+     *       const std::vector<DBL> &A, &B;
+     *   - sum of results (keeps calls from optimization):
+     *       DBL *Sum;
+     * RETURNS:
+     *   (BOOL) TRUE if results are equal, FALSE otherwise.
+     */
+    template<typename Type>
+      static BOOL MthBatches( const CHAR *TypeName, const std::vector<DBL> &A, const std::vector<DBL> &B, DBL *Sum )
+      {
+        const CHAR *BatchNames[] {"points", "vectors", "normals", "rays"};
+        const INT BatchSize = 1024, BatchRounds = 256;
+        mth::matr<Type> Mb =
+          mth::matr<Type>::Scale(mth::vec3<Type>(2, 3, 0.5)) * mth::matr<Type>::RotateX(30) *
+          mth::matr<Type>::Translate(mth::vec3<Type>(1, -2, 5));
+        mth::vec3_batch<Type> Src;
+        mth::ray_batch<Type> Rays;
+        std::vector<mth::vec3<Type>> ItemsSrc;
+        std::vector<mth::ray<Type>> RaysSrc;
+        BOOL IsEqual = TRUE;
+
+        for (INT i = 0; i < BatchSize; i++)
+        {
+          ItemsSrc.push_back(mth::vec3<Type>((Type)A[i * 3], (Type)A[i * 3 + 1], (Type)A[i * 3 + 2]));
+          RaysSrc.push_back(mth::ray<Type>(mth::vec3<Type>((Type)B[i * 3], (Type)B[i * 3 + 1], (Type)B[i * 3 + 2]), ItemsSrc[i]));
+          Src.Push(ItemsSrc[i]);
+          Rays.Push(RaysSrc[i]);
+        }
+        std::cout << "Batch transformations (" << BatchSize << " items, " << TypeName << "), Mitems/s:" << std::endl;
+        std::cout << "  kernel          per item    batch  max diff" << std::endl;
+        for (INT Mode = 0; Mode < 4; Mode++)
+        {
+          std::vector<mth::vec3<Type>> Items(BatchSize);
+          std::vector<mth::ray<Type>> ItemRays(BatchSize);
+          mth::vec3_batch<Type> Batch;
+          mth::ray_batch<Type> BatchRays;
+          DBL MaxDiff = 0, T[2];
+          BOOL IsBatchEqual = TRUE;
+
+          for (INT Pass = 0; Pass < 2; Pass++)
+          {
+            auto Start = std::chrono::steady_clock::now();
+
+            for (INT j = 0; j < BatchRounds; j++)
+              if (Pass == 0)
+                for (INT i = 0; i < BatchSize; i++)
+                  if (Mode == 0)
+                    Items[i] = Mb.TransformPoint(ItemsSrc[i]);
+                  else if (Mode == 1)
+                    Items[i] = Mb.TransformVector(ItemsSrc[i]);
+                  else if (Mode == 2)
+                    Items[i] = Mb.TransformNormal(ItemsSrc[i]);
+                  else
+                    ItemRays[i] = mth::ray<Type>(Mb.TransformPoint(RaysSrc[i].Org), Mb.TransformVector(RaysSrc[i].Dir));
+              else if (Mode < 3)
+              {
+                // Batch is transformed in place, so source is copied every round
+                Batch = Src;
+                if (Mode == 0)
+                  Batch.TransformPoints(Mb);
+                else if (Mode == 1)
+                  Batch.TransformVectors(Mb);
+                else
+                  Batch.TransformNormals(Mb);
+              }
+              else
+              {
+                BatchRays = Rays;
+                BatchRays.Transform(Mb);
+              }
+            T[Pass] = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - Start).count();
+          }
+          // Rays are compared by origins and directions
+          if (Mode == 3)
+          {
+            Items.clear();
+            Batch.Clear();
+            for (INT i = 0; i < BatchSize; i++)
+            {
+              mth::ray<Type> R = BatchRays.Get(i);
+
+              Items.push_back(ItemRays[i].Org);
+              Items.push_back(ItemRays[i].Dir);
+              Batch.Push(R.Org);
+              Batch.Push(R.Dir);
+            }
+          }
+          *Sum += Items[0].X + Batch.X[0];
+          for (INT i = 0; i < Batch.Size(); i++)
+          {
+            mth::vec3<Type> D = Items[i] - Batch.Get(i);
+
+            MaxDiff = (std::max)(MaxDiff, (DBL)(std::max)((std::max)(fabs(D.X), fabs(D.Y)), fabs(D.Z)));
+            if (Items[i].X != Batch.X[i] || Items[i].Y != Batch.Y[i] || Items[i].Z != Batch.Z[i])
+              IsBatchEqual = FALSE;
+          }
+          IsEqual &= IsBatchEqual;
+          std::cout << "  " << std::left << std::setw(14) << BatchNames[Mode] << std::right <<
+            std::fixed << std::setprecision(1) << std::setw(10) << BatchRounds * BatchSize / T[0] / 1e6 <<
+            " " << std::setw(8) << BatchRounds * BatchSize / T[1] / 1e6 << std::defaultfloat <<
+            "  " << MaxDiff << (IsBatchEqual ? "" : "  MISMATCH") << std::endl;
+        }
+        return IsEqual;
+      } /* End of 'MthBatches' function */
+
+    /* Check math SIMD kernels by scalar ones function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) process exit code.
+     */
+    INT rt_cli::MthCheck( VOID )
+    {
+      const INT Count = 4096;
+      std::vector<DBL> A(Count * 16), B(Count * 16);
+      BOOL IsEqual = TRUE;
+      DBL Sum = 0;
+
+      srand(30);
+      for (INT i = 0; i < Count * 16; i++)
+      {
+        // Values of different magnitudes, so rounding order matters
+        A[i] = (rand() - RAND_MAX / 2) * pow(10.0, rand() % 9 - 4) / RAND_MAX;
+        B[i] = (rand() - RAND_MAX / 2) * pow(10.0, rand() % 9 - 4) / RAND_MAX;
+      }
+      // Float kernels get the same (rounded) arguments
+      std::vector<FLT> Af(A.begin(), A.end()), Bf(B.begin(), B.end());
+
+      IsEqual &= MthKernels("double", A, B, &Sum);
+      IsEqual &= MthKernels("float", Af, Bf, &Sum);
+      // Batch transformations against per item ones
+      IsEqual &= MthBatches<DBL>("double", A, B, &Sum);
+      IsEqual &= MthBatches<FLT>("float", A, B, &Sum);
+      std::cout << (IsEqual ? "All kernels match scalar ones" : "Kernels results differ") << std::endl;
+      std::cout << "Checksum: " << Sum / Count << std::endl;
+      return IsEqual ? 0 : 1;
+    } /* End of 'rt_cli::MthCheck' function */
+
+    /* Run textures sampling benchmark function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) process exit code.
+     */
+    INT rt_cli::TexBench( VOID )
+    {
+      /* Texture storage class */
+      class storage
+      {
+      public:
+        const CHAR *Name;           // Storage name
+        texture::LAYOUT Layout;     // Texels layout
+        texture::FORMAT Format;     // Texels format
+      };
+      const storage Storages[]
+      {
+        {"linear", texture::LINEAR, texture::BGRA8},
+        {"tiled", texture::TILED, texture::BGRA8},
+        {"float", texture::TILED, texture::RGB32F},
+        {"bc1", texture::TILED, texture::BC1},
+      };
+      const INT Count = 1 << 22;
+      const DBL Angles[] {0, 45, 90};
+      INT First = TexManager.TexCount;
+      BOOL OldIsLazy = TexManager.IsLazy;
+
+      TexManager.IsLazy = TRUE;
+      g3dm Model(TexBenchFileName);
+      TexManager.IsLazy = OldIsLazy;
+
+      texture::FILTER OldFilter = texture::Filter;
+      texture::LAYOUT OldLayout = texture::DefaultLayout;
+      texture::FORMAT OldFormat = texture::DefaultFormat;
+      vec3 Sum;
+
+      if (TexManager.TexCount == First)
+      {
+        std::cerr << "No textures in '" << TexBenchFileName << "'" << std::endl;
+        return 1;
+      }
+      texture::Filter = texture::BILINEAR;
+      std::cout << "Texture sampling (bilinear, level 0), Msamples/s:" << std::endl;
+      std::cout << "  texture    size       storage     MB    0 deg   45 deg   90 deg" << std::endl;
+      for (INT No = First; No < TexManager.TexCount; No++)
+      {
+        texture *Tex = TexManager.GetTexByNo(No);
+
+        if (Tex == nullptr)
+          continue;
+        for (auto &S : Storages)
+        {
+          texture::DefaultLayout = S.Layout;
+          texture::DefaultFormat = S.Format;
+          Tex->Load();
+          if (Tex->LevelsCount() == 0)
+            break;
+          std::cout << "  " << std::setw(7) << No << "    " << std::setw(4) << Tex->GetW() << "x" <<
+            std::left << std::setw(4) << Tex->GetH() << "  " << std::setw(8) << S.Name << std::right <<
+            std::fixed << std::setprecision(1) << std::setw(6) << Tex->MemorySize() / 1048576.0 << " ";
+          for (DBL a : Angles)
+            std::cout << " " << std::setw(8) << Count / TexWalk(*Tex, a, Count, &Sum) / 1e6;
+          std::cout << std::defaultfloat << std::endl;
+        }
+        Tex->Free();
+      }
+      texture::Filter = OldFilter;
+      texture::DefaultLayout = OldLayout;
+      texture::DefaultFormat = OldFormat;
+      std::cout << "Checksum: " << (Sum.X + Sum.Y + Sum.Z) / Count << std::endl;
+      return 0;
+    } /* End of 'rt_cli::TexBench' function */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+/* END OF 'rt_cli_bench.cpp' FILE */
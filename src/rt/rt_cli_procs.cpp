@@ -0,0 +1,298 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        rt_cli_procs.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's headless renderer multi-process mode file.
+ * NOTE:        Coordinator forks worker processes after scene loading,
+ *              so workers share scene data copy-on-write. Worker #i
+ *              renders tiles i, i + N, i + 2N, ... and sends them
+ *              through pipe as (INT tile number, tile pixels) records,
+ *              finished by -1 tile number. Pixel values do not depend
+ *              on the renderer process, so merged image is the same
+ *              as single-process one.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "pirt.h"
+#include "rt_cli.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <cerrno>
+#endif // _WIN32
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+#ifndef _WIN32
+    /* Write whole buffer to file descriptor function.
+     * ARGUMENTS:
+     *   - file descriptor:
+     *       INT Fd;
+     *   - buffer:
+     *       const VOID *Buf;
+     *   - buffer size in bytes:
+     *       UINT_PTR Size;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    static BOOL WriteAll( INT Fd, const VOID *Buf, UINT_PTR Size )
+    {
+      const BYTE *ptr = reinterpret_cast<const BYTE *>(Buf);
+
+      while (Size > 0)
+      {
+        INT_PTR n = write(Fd, ptr, Size);
+
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          return FALSE;
+        ptr += n;
+        Size -= n;
+      }
+      return TRUE;
+    } /* End of 'WriteAll' function */
+
+    /* Pin current process to part of available processors function.
+     * ARGUMENTS:
+     *   - worker number and workers count:
+     *       INT No, Count;
+     * RETURNS: None.
+     */
+    static VOID PinWorker( INT No, INT Count )
+    {
+#ifdef __linux__
+      cpu_set_t All, Part;
+      std::vector<INT> Cpus;
+
+      if (sched_getaffinity(0, sizeof(All), &All) != 0)
+        return;
+      for (INT i = 0; i < CPU_SETSIZE; i++)
+        if (CPU_ISSET(i, &All))
+          Cpus.push_back(i);
+      if ((INT)Cpus.size() < Count)
+        return;
+
+      // Contiguous processors range (neighbour cores usually share socket)
+      INT
+        First = (INT)Cpus.size() * No / Count,
+        Last = (INT)Cpus.size() * (No + 1) / Count;
+
+      CPU_ZERO(&Part);
+      for (INT i = First; i < Last; i++)
+        CPU_SET(Cpus[i], &Part);
+      sched_setaffinity(0, sizeof(Part), &Part);
+#endif // __linux__
+    } /* End of 'PinWorker' function */
+
+    /* Worker process main function.
+     * ARGUMENTS:
+     *   - renderer:
+     *       rt_cli *Cli;
+     *   - worker number:
+     *       INT No;
+     *   - pipe write descriptor:
+     *       INT Fd;
+     * RETURNS:
+     *   (INT) process exit code.
+     */
+    static INT WorkerMain( rt_cli *Cli, INT No, INT Fd )
+    {
+      tile_grid Grid(Cli->W, Cli->H, Cli->Scene.TileSize);
+
+      if (Cli->IsPin)
+        PinWorker(No, Cli->ProcsCount);
+
+      Cli->Scene.RenderTiles(Cli->Camera, Cli->Frame, No, Cli->ProcsCount);
+
+      std::vector<DWORD> Buf((UINT_PTR)Grid.Size * Grid.Size);
+
+      for (INT t = No; t < Grid.Count(); t += Cli->ProcsCount)
+      {
+        tile T = Grid[t];
+
+        Cli->Frame.GetRect(T.X0, T.Y0, T.W, T.H, Buf.data());
+        if (!WriteAll(Fd, &t, sizeof(t)) ||
+            !WriteAll(Fd, Buf.data(), (UINT_PTR)T.W * T.H * sizeof(DWORD)))
+          return 1;
+      }
+
+      INT End = -1;
+
+      return WriteAll(Fd, &End, sizeof(End)) ? 0 : 1;
+    } /* End of 'WorkerMain' function */
+
+    /* Worker process connection class */
+    class worker_link
+    {
+    public:
+      pid_t Pid = -1;             // Worker process id
+      INT Fd = -1;                // Pipe read descriptor
+      std::vector<BYTE> Data;     // Received but not processed data
+      BOOL IsFinished = FALSE;    // End record received flag
+    }; /* End of 'worker_link' class */
+#endif // _WIN32
+
+    /* Render scene by several worker processes function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL rt_cli::RenderProcs( VOID )
+    {
+#ifdef _WIN32
+      std::cerr << "Multi-process rendering is not supported on this platform" << std::endl;
+      return FALSE;
+#else  // _WIN32
+      tile_grid Grid(W, H, Scene.TileSize);
+      std::vector<worker_link> Workers(ProcsCount);
+      std::vector<BOOL> IsTileDone(Grid.Count(), FALSE);
+      INT TilesDone = 0;
+      BOOL IsOk = TRUE;
+
+      std::cout.flush();
+      for (INT i = 0; i < ProcsCount; i++)
+      {
+        INT Fds[2];
+
+        if (pipe(Fds) != 0)
+        {
+          std::cerr << "Cannot create pipe" << std::endl;
+          IsOk = FALSE;
+          break;
+        }
+
+        pid_t Pid = fork();
+
+        if (Pid == 0)
+        {
+          close(Fds[0]);
+          for (INT j = 0; j < i; j++)
+            close(Workers[j].Fd);
+          _exit(WorkerMain(this, i, Fds[1]));
+        }
+        close(Fds[1]);
+        if (Pid < 0)
+        {
+          std::cerr << "Cannot start worker process" << std::endl;
+          close(Fds[0]);
+          IsOk = FALSE;
+          break;
+        }
+        Workers[i].Pid = Pid;
+        Workers[i].Fd = Fds[0];
+      }
+
+      // Receive tiles from all workers
+      std::vector<BYTE> Buf(1 << 16);
+
+      while (IsOk)
+      {
+        std::vector<pollfd> Polls;
+        std::vector<worker_link *> Links;
+
+        for (auto &Wrk : Workers)
+          if (Wrk.Fd >= 0)
+            Polls.push_back({Wrk.Fd, POLLIN, 0}), Links.push_back(&Wrk);
+        if (Polls.empty())
+          break;
+        if (poll(Polls.data(), Polls.size(), -1) < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          IsOk = FALSE;
+          break;
+        }
+
+        for (UINT_PTR k = 0; k < Polls.size(); k++)
+        {
+          if (Polls[k].revents == 0)
+            continue;
+
+          worker_link &Wrk = *Links[k];
+          INT_PTR n = read(Wrk.Fd, Buf.data(), Buf.size());
+
+          if (n < 0 && errno == EINTR)
+            continue;
+          if (n <= 0)
+          {
+            close(Wrk.Fd);
+            Wrk.Fd = -1;
+            continue;
+          }
+          Wrk.Data.insert(Wrk.Data.end(), Buf.begin(), Buf.begin() + n);
+
+          // Process all complete records
+          UINT_PTR Pos = 0;
+
+          while (Wrk.Data.size() - Pos >= sizeof(INT))
+          {
+            INT No;
+
+            std::memcpy(&No, Wrk.Data.data() + Pos, sizeof(INT));
+            if (No == -1)
+            {
+              Wrk.IsFinished = TRUE;
+              Pos += sizeof(INT);
+              continue;
+            }
+            if (No < 0 || No >= Grid.Count() || IsTileDone[No])
+            {
+              std::cerr << "Invalid tile received from worker process" << std::endl;
+              IsOk = FALSE;
+              break;
+            }
+
+            tile T = Grid[No];
+            UINT_PTR Size = sizeof(INT) + (UINT_PTR)T.W * T.H * sizeof(DWORD);
+
+            if (Wrk.Data.size() - Pos < Size)
+              break;
+            Frame.PutRect(T.X0, T.Y0, T.W, T.H,
+              reinterpret_cast<const DWORD *>(Wrk.Data.data() + Pos + sizeof(INT)));
+            IsTileDone[No] = TRUE;
+            TilesDone++;
+            Pos += Size;
+          }
+          Wrk.Data.erase(Wrk.Data.begin(), Wrk.Data.begin() + Pos);
+        }
+      }
+
+      // Wait all workers
+      for (auto &Wrk : Workers)
+      {
+        INT Status = 0;
+
+        if (Wrk.Fd >= 0)
+          close(Wrk.Fd);
+        if (Wrk.Pid > 0 &&
+            (waitpid(Wrk.Pid, &Status, 0) != Wrk.Pid ||
+             !WIFEXITED(Status) || WEXITSTATUS(Status) != 0 || !Wrk.IsFinished))
+          IsOk = FALSE;
+      }
+
+      if (IsOk && TilesDone != Grid.Count())
+        IsOk = FALSE;
+      if (!IsOk)
+        std::cerr << "Multi-process render failed (" << TilesDone << " of " <<
+          Grid.Count() << " tiles received)" << std::endl;
+      return IsOk;
+#endif // _WIN32
+    } /* End of 'rt_cli::RenderProcs' function */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+/* END OF 'rt_cli_procs.cpp' FILE */
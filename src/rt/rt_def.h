@@ -5,7 +5,7 @@
 
 /* FILE:        rt_def.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 05.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's basic defines header file.
  * NOTE:        None.
  * 
@@ -31,7 +31,7 @@ namespace pirt
     class envi
     {
     public:
-      DBL
+      REAL
         RefractionCoef, // Refraction coefficient
         Decay;          // Environment media decay coefficient
     }; /* End of 'envi' class */
@@ -42,7 +42,7 @@ namespace pirt
     public:
       vec3 L;           // Light source direction
       vec3 Color;       // Light source color
-      DBL Dist;         // Distance to light source
+      REAL Dist;        // Distance to light source
     }; /* End of 'light_info' class */
 
 
@@ -50,20 +50,26 @@ namespace pirt
     class light
     {
     public:
-      DBL Cc, Cl, Cq;   // Attenuation coefficients
+      REAL Cc, Cl, Cq;  // Attenuation coefficients
       vec3 Color;       // Light source color
+      INT SamplesSide = 1; // Shadow samples grid side (power of 2, 1 - single shadow ray)
 
       /* Constructor by all parameters.
        * ARGUMENTS:
        *   - attenuation coefficients:
-       *       DBL cc, cl, cq;
+       *       REAL cc, cl, cq;
        *   - color:
        *       vec3 color;
        */
-      light( DBL cc, DBL cl, DBL cq, vec3 color ) : Cc(cc), Cl(cl), Cq(cq), Color(color)
+      light( REAL cc, REAL cl, REAL cq, vec3 color ) : Cc(cc), Cl(cl), Cq(cq), Color(color)
       {
       } /* End of 'light' function */
 
+      /* Default destructor */
+      virtual ~light( VOID )
+      {
+      } /* End of '~light' function */
+
       /* Light shadow evaluvating function.
        * ARGUMENTS:
        *   - point:
@@ -71,20 +77,93 @@ namespace pirt
        *   - light_info:
        *       light_info *L;
        * RETURNS:
-       *   (DBL) information about shadow.
+       *   (REAL) information about shadow.
        */
-      virtual DBL Shadow( const vec3 &P, light_info *L )
+      virtual REAL Shadow( const vec3 &P, light_info *L )
       {
         return 0.0;
       } /* End of 'Shadow' function */
 
+      /* Get light influence sphere function.
+       * ARGUMENTS:
+       *   - contribution (attenuated color maximal component) cut off:
+       *       REAL Cutoff;
+       *   - sphere to be set:
+       *       vec3 *C;
+       *       REAL *R;
+       * RETURNS:
+       *   (BOOL) TRUE if light is bounded, FALSE if it may influence any point.
+       */
+      virtual BOOL GetInfluence( REAL Cutoff, vec3 *C, REAL *R ) const
+      {
+        return FALSE;
+      } /* End of 'GetInfluence' function */
+
+      /* Get light surface sample point (area lights) function.
+       * ARGUMENTS:
+       *   - lit point:
+       *       const vec3 &P;
+       *   - sample in [0, 1)^2 (strata are kept):
+       *       const vec2 &U;
+       * RETURNS:
+       *   (vec3) light surface point.
+       */
+      virtual vec3 SamplePoint( const vec3 &P, const vec2 &U ) const
+      {
+        return P;
+      } /* End of 'SamplePoint' function */
+
+      /* Get light surface bound box (area lights) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS: None.
+       */
+      virtual VOID GetBound( vec3 *Min, vec3 *Max ) const
+      {
+      } /* End of 'GetBound' function */
+
+      /* Get attenuation by distance function.
+       * ARGUMENTS:
+       *   - distance:
+       *       REAL D;
+       * RETURNS:
+       *   (REAL) attenuation factor 1 / (Cc + Cl * D + Cq * D^2).
+       */
+      REAL Attenuation( REAL D ) const
+      {
+        REAL K = Cc + Cl * D + Cq * D * D;
+
+        return K > Threshold ? 1 / K : 1 / Threshold;
+      } /* End of 'Attenuation' function */
+
+      /* Get distance at which attenuated contribution falls to cut off function.
+       * ARGUMENTS:
+       *   - contribution cut off:
+       *       REAL Cutoff;
+       * RETURNS:
+       *   (REAL) influence radius (negative if contribution never falls to cut off).
+       */
+      REAL InfluenceRadius( REAL Cutoff ) const
+      {
+        REAL K = Color.MaxComponent() / (Cutoff > 0 ? Cutoff : Threshold) - Cc;
+
+        if (K <= 0)
+          return 0;
+        if (Cq > 0)
+          return (-Cl + sqrt(Cl * Cl + 4 * Cq * K)) / (2 * Cq);
+        if (Cl > 0)
+          return K / Cl;
+        return -1;
+      } /* End of 'InfluenceRadius' function */
+
     }; /* End of 'light' class */
 
     /* Intersection class */
     class intr
     {
     public:
-      DBL   T;          // Intersection ray distance
+      REAL  T;          // Intersection ray distance
       shape *Shp;       // Intersected shape
 
       //----------------------------------
@@ -100,6 +179,8 @@ namespace pirt
       BOOL  IsN;        // Exis normal flag
 
       INT   M;          // Material of intersection element. (outdated)
+      REAL  Footprint = 0; // Ray footprint width on surface (0 if not known, for texture filtering)
+      vec3  dPdx, dPdy; // Intersection point derivatives by frame X and Y (zero if not known)
 
       /* Ray object entering flag */
       enum ENTER_TYPE
@@ -113,7 +194,7 @@ namespace pirt
       // Cache addon:
       //----------------------------------
       INT    I[2];         // Integer data array addon.
-      DBL    D[2];         // Double float data array addon.
+      REAL   D[2];         // Renderer scalar data array addon.
       vec3   V[2];         // 3D vector (double) data array addon.
       const VOID *Ptr[2]; // Pointers data array addon.
       
@@ -146,9 +227,9 @@ namespace pirt
        *   - ka, kd, ks:
        *       vec3 ka, kd, ks;
        *   - ph:
-       *       DBL ph;
+       *       REAL ph;
        */
-      shape( vec3 ka, vec3 kd, vec3 ks, DBL ph ) :
+      shape( vec3 ka, vec3 kd, vec3 ks, REAL ph ) :
         Surf(ka, kd, ks, ph) // any material
       {
       } /* End of 'shape' function */
@@ -288,6 +369,18 @@ namespace pirt
         return vec3(0);
       } /* End of 'Mode' function */
 
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      virtual BOOL GetBound( vec3 *Min, vec3 *Max ) const
+      {
+        return FALSE;
+      } /* End of 'GetBound' function */
+
     }; /* End of 'shape' class */
   } /* end of 'rt' namespace */
 } /* end of 'pirt' namespace */
@@ -5,7 +5,7 @@
 
 /* FILE:        rt_scene.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 05.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's scene header file.
  * NOTE:        None.
  * 
@@ -16,9 +16,22 @@
 #ifndef __rt_scene_h_
 #define __rt_scene_h_
 
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <limits>
+
 #include "rt_def.h"
+#include "frame.h"
+#include "tiles.h"
+#include "thread_pool.h"
+#include "sampler.h"
+#include "denoise.h"
 /* Lights headers */
 #include "lights/point.h"
+#include "lights/area.h"
+#include "lights/light_grid.h"
 
 /* Base project namespace */
 namespace pirt
@@ -36,8 +49,8 @@ namespace pirt
       std::atomic_bool IsRenderActive = FALSE;  // Is render active flag
       std::atomic_bool IsToBeStop = FALSE;      // Is to be stop flag
       std::atomic_bool IsReadyToFinish = TRUE;  // Is ready to finish flag
-      // Store rendering line
-      std::atomic_int StartRow = 0;             // Store rendering line counting
+      // Store rendering tile
+      std::atomic_int StartTile = 0;            // Store rendering tile counting
 
       //-----------------------------
       // Scene shapes storage:
@@ -65,12 +78,55 @@ namespace pirt
       vec3 
         AmbientColor = vec3(0.0, 0.0, 0.0),     // Ambient color of scene
         BackgroundColor = vec3(0.3, 0.47, 0.8), // Background color of scene
-        FogColor;                               // Fog color of scene
-      DBL 
-        FogStart,                               // Fog start coefficient
-        FogEnd;                                 // Fog end coefficient
+        FogColor = vec3(0.5, 0.5, 0.5);         // Fog color of scene
+
+      /* Fog falloff modes */
+      enum FOG_MODE
+      {
+        FOG_NONE,                               // No fog
+        FOG_LINEAR,                             // Linear from FogStart to FogEnd distance
+        FOG_EXP,                                // Exponential by distance after FogStart
+        FOG_HEIGHT                              // Exponential with density falling off by height
+      } FogMode = FOG_NONE;                     // Current fog mode
+      REAL 
+        FogStart = 0,                           // Fog start path distance (all modes)
+        FogEnd = 100,                           // Fog end (full fog) path distance (linear mode)
+        FogDensity = 0.05,                      // Fog density (exponential and height modes)
+        FogHeight = 0,                          // Fog density base level (height mode)
+        FogFalloff = 0.5;                       // Fog density falloff by height (height mode)
+      static constexpr REAL FogCutoff = 1.0 / 512; // Transmittance below which ray is fully fogged
+
+      /* Shape bound box (cached for render) class */
+      class shape_bound
+      {
+      public:
+        vec3 Min, Max;                          // Shape space bound box
+        BOOL IsBounded;                         // Shape is bounded flag
+      }; /* End of 'shape_bound' class */
+      std::vector<shape_bound> ShapeBounds;     // Shapes bounds (rebuilt on every render with fog)
       stock<light *> 
         Lights;                                 // Stock for storage light of scene
+      BOOL IsAttenuation = FALSE;               // Apply lights attenuation (and cull lights by it) flag
+      REAL LightCutoff = 1.0 / 512;             // Attenuated light contribution cut off
+      light_grid LightGrid;                     // Lights influence grid (rebuilt on every render)
+
+      /* Shadow rays last occluders (per render thread) cache class */
+      class shadow_cache
+      {
+      public:
+        std::vector<INT> Occluders;             // Last occluder shape number by light number (-1 if no)
+        UINT64 Tests = 0, Hits = 0;             // Cache tests and hits count
+      }; /* End of 'shadow_cache' class */
+      BOOL IsShadowCache = TRUE;                // Test last occluder before full shadow query flag
+      std::atomic<UINT64>
+        ShadowCacheTests = 0,                   // Shadow cache tests count (from last counters reset)
+        ShadowCacheHits = 0;                    // Shadow cache hits count (from last counters reset)
+      static inline thread_local shadow_cache
+        *CurShadow = nullptr;                   // Shadow cache of current render thread
+      INT AreaEarlySamples = 4;                 // Area light samples which decide fully lit or occluded points
+      std::atomic<UINT64>
+        AreaShadowRays = 0,                     // Area lights shadow rays count (from last counters reset)
+        AreaShadowSkipped = 0;                  // Area lights shadow rays skipped by early out
 
       /* Add light to scene function.
        * ARGUMENTS:
@@ -92,7 +148,7 @@ namespace pirt
         vec3 P;                                 // Point of shading evaluation
         vec3 N;                                 // Point normal
         shape *Shp;                             // Shape pointer
-        surface Surf;                           // Surface material
+        const surface *Surf;                    // Surface material (shape owned, not copied)
         envi Media;                             // Object media environment
         vec3 Du, Dv;                            // Tangent vectors
         intr *In;                               // Intersection
@@ -106,69 +162,580 @@ namespace pirt
         MaxRecLevel = 5;                        // Maximal avaliable recurse level
       envi Air;                                 // Air enviroment data
 
+      //-----------------------------
+      // Path termination parameters:
+      //-----------------------------
+      REAL MinThroughput = 0.02;                // Path throughput cut off (without Russian roulette)
+      BOOL IsRoulette = FALSE;                  // Russian roulette path termination flag
+      INT RouletteDepth = 2;                    // Bounces count before Russian roulette is played
+      REAL RouletteThreshold = 0.25;            // Path throughput below which Russian roulette is played
+      std::atomic<UINT64>
+        KilledByDepth = 0,                      // Paths terminated by maximal recurse level
+        KilledByThroughput = 0,                 // Paths terminated by throughput cut off
+        KilledByRoulette = 0;                   // Paths terminated by Russian roulette
+
+      /* Path sample (for path random decisions) class */
+      class path_sample
+      {
+      public:
+        INT X, Y;                               // Pixel coordinates
+        INT No, Count;                          // Sample number and samples count in pixel
+      }; /* End of 'path_sample' class */
+      static inline thread_local path_sample
+        CurPath {0, 0, 0, 1};                   // Path traced by current thread (recursive tracing)
+
+      //-----------------------------
+      // Render parameters:
+      //-----------------------------
+      INT
+        ThreadsCount = 0,                       // Count of render threads (0 - all hardware threads)
+        SampleGrid = 2,                         // Sub-pixel samples grid side (SampleGrid^2 samples per pixel)
+        TileSize = 32;                          // Render tile side size
+      sampler Sampler;                          // Samples generator
+      BOOL IsRayDiff = TRUE;                    // Trace ray differentials (for texture filtering) flag
+      REAL DiffStep = 1;                        // Primary rays differentials step in pixels (set on render)
+      static inline thread_local ray_diff
+        CurDiff {};                             // Differentials of ray traced by current thread
+      static inline thread_local REAL
+        CurPathDist = 0;                        // Path distance to origin of ray traced by current thread (for fog)
+
+      /* Wavefront queues sorting flags */
+      enum WAVE_SORT
+      {
+        WAVE_SORT_NONE = 0,                     // Process queues in generation order
+        WAVE_SORT_OCTANT = 1,                   // Sort rays by direction octant before intersection
+        WAVE_SORT_SHAPE = 2                     // Sort hits by shape and material before shading
+      };
+      BOOL IsWavefront = FALSE;                 // Breadth-first (wavefront) tiles render flag
+      INT WaveSort = WAVE_SORT_NONE;            // Wavefront queues sorting flags (WAVE_SORT_***)
+
+      //-----------------------------
+      // Primary hits cache (G-buffer):
+      //-----------------------------
+      BOOL IsGBuffer = FALSE;                   // Store primary hits while rendering flag
+      std::vector<intr> GBuffer;                // Primary hit of every pixel sample (Shp == nullptr for miss)
+      INT GBufferW = 0, GBufferH = 0,           // G-buffer frame size
+        GBufferSamples = 0;                     // G-buffer samples per pixel
+      std::atomic_bool IsRelight = FALSE;       // Render from G-buffer (relight pass) flag
+
+      //-----------------------------
+      // Tiles references tracking (for dirty tiles re-render):
+      //-----------------------------
+      BOOL IsTrackTiles = FALSE;                // Track shapes and space referenced by tiles flag
+      std::vector<tile_refs> TileRefs;          // References of every tile
+      INT RefsW = 0, RefsH = 0, RefsTileSize = 0; // References frame size and tile size
+      static inline thread_local tile_refs
+        *CurRefs = nullptr;                     // References of tile rendered by current thread
+
+      //-----------------------------
+      // Denoiser:
+      //-----------------------------
+      BOOL IsDenoise = FALSE;                   // Collect denoiser guide buffers at full resolution render flag
+      aux_buffers Aux;                          // Denoiser guide buffers of last render
+      denoiser Denoiser;                        // Denoiser (with parameters)
+      static inline thread_local aux_texel
+        *CurAux = nullptr;                      // Primary hits of pixel rendered by current thread
+      thread_pool Pool;                         // Render threads (kept between renders)
+
       //-----------------------------
       // Scene render methods:
       //-----------------------------
 
-      /* Render scene function.
+      /* Render one pixel function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - pixel coordinates:
+       *       INT X, Y;
+       * RETURNS:
+       *   (DWORD) pixel color.
+       */
+      DWORD RenderPixel( const camera &Cam, INT X, INT Y )
+      {
+        const INT l = SampleGrid > 0 ? SampleGrid : 1, n = l * l;
+        vec3 c;
+        aux_texel At;
+
+        if (IsDenoise)
+          CurAux = &At;
+        for (INT k = 0; k < n; ++k)
+        {
+          vec2 o = Sampler.Get2D(X, Y, k, n, 0);
+          ray r = PrimaryRay(Cam, X + o.X, Y + o.Y, &CurDiff);
+
+          CurPath = {X, Y, k, n};
+          if (IsRelight)
+            c += TraceCached(r, GBuffer[((UINT_PTR)Y * GBufferW + X) * n + k]);
+          else if (IsGBuffer)
+            c += TracePrimary(r, &GBuffer[((UINT_PTR)Y * GBufferW + X) * n + k]);
+          else
+            c += Trace(r, Air, 1);
+        }
+        CurAux = nullptr;
+
+        c /= n;
+        if (IsDenoise)
+          Aux.Put(X, Y, c, At, n);
+        return frame::ToRGB(c.X, c.Y, c.Z);
+      } /* End of 'RenderPixel' function */
+
+      /* Render tile to buffer function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - tile:
+       *       const tile &T;
+       *   - destination buffer (T.W * T.H pixels, row by row):
+       *       DWORD *Buf;
+       * RETURNS: None.
+       */
+      VOID RenderTile( const camera &Cam, const tile &T, DWORD *Buf )
+      {
+        for (INT y = 0; y < T.H; y++)
+          for (INT x = 0; x < T.W; x++)
+            *Buf++ = RenderPixel(Cam, T.X0 + x, T.Y0 + y);
+      } /* End of 'RenderTile' function */
+
+      /* Wavefront path (one pixel sample) ray class */
+      class wave_ray
+      {
+      public:
+        ray R;                                  // Ray
+        vec3 Thr;                               // Path throughput
+        REAL Weight;                            // Path weight (for reflection cut off)
+        INT Level;                              // Recursion level of ray
+        INT Sample;                             // Path sample number in tile
+        ray_diff Diff;                          // Ray differentials
+        REAL Dist;                              // Path distance to ray origin (for fog)
+      }; /* End of 'wave_ray' class */
+
+      /* Wavefront path hit class */
+      class wave_hit
+      {
+      public:
+        INT Ray;                                // Ray number in queue
+        intr In;                                // Intersection
+      }; /* End of 'wave_hit' class */
+
+      /* Wavefront shadow ray class */
+      class wave_shadow
+      {
+      public:
+        ray R;                                  // Ray to light
+        REAL Dist;                              // Distance to light (negative if visibility is already applied)
+        vec3 Color;                             // Light contribution if not occluded
+        INT Sample;                             // Path sample number in tile
+        INT Light;                              // Light number
+      }; /* End of 'wave_shadow' class */
+
+      /* Wavefront queues (per render thread) class */
+      class wave_queues
+      {
+      public:
+        std::vector<wave_ray> Rays, NextRays;   // Current and next bounce rays
+        std::vector<wave_hit> Hits;             // Compacted hits
+        std::vector<wave_shadow> Shadows;       // Shadow rays
+        std::vector<BOOL> IsLit;                // Shadow rays results
+        std::vector<INT> Order;                 // Queue processing order
+        std::vector<vec3> Colors;               // Samples colors
+        std::vector<aux_texel> Aux;             // Pixels primary hits (for denoiser)
+      }; /* End of 'wave_queues' class */
+
+      /* Get ray direction octant function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray &R;
+       * RETURNS:
+       *   (INT) octant number [0..7].
+       */
+      static INT Octant( const ray &R )
+      {
+        return (R.Dir.X < 0) | (R.Dir.Y < 0) << 1 | (R.Dir.Z < 0) << 2;
+      } /* End of 'Octant' function */
+
+      /* Render tile to buffer by wavefront (breadth-first) tracing function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - tile:
+       *       const tile &T;
+       *   - destination buffer (T.W * T.H pixels, row by row):
+       *       DWORD *Buf;
+       *   - render thread queues:
+       *       wave_queues &Q;
+       * RETURNS: None.
+       * NOTE: Sum is the same as 'Trace'/'Shade' recursion, but grouped by
+       *       bounces, so result may differ in last digits.
+       */
+      VOID RenderTileWavefront( const camera &Cam, const tile &T, DWORD *Buf, wave_queues &Q )
+      {
+        const INT l = SampleGrid > 0 ? SampleGrid : 1, n = l * l;
+
+        // Primary rays
+        Q.Rays.clear();
+        Q.Colors.assign((UINT_PTR)T.W * T.H * n, vec3(0));
+        if (IsDenoise)
+          Q.Aux.assign((UINT_PTR)T.W * T.H, aux_texel());
+        for (INT y = 0; y < T.H; y++)
+          for (INT x = 0; x < T.W; x++)
+            for (INT k = 0; k < n; k++)
+            {
+              vec2 o = Sampler.Get2D(T.X0 + x, T.Y0 + y, k, n, 0);
+
+              ray_diff Diff;
+              ray R = PrimaryRay(Cam, T.X0 + x + o.X, T.Y0 + y + o.Y, &Diff);
+
+              Q.Rays.push_back({R, vec3(1), 1, 0, (y * T.W + x) * n + k, Diff, 0});
+            }
+
+        auto Sort =
+          [&]( UINT_PTR Count, const auto &Key )
+          {
+            Q.Order.resize(Count);
+            for (UINT_PTR i = 0; i < Count; i++)
+              Q.Order[i] = (INT)i;
+            std::stable_sort(Q.Order.begin(), Q.Order.end(),
+              [&]( INT A, INT B ){ return Key(A) < Key(B); });
+          };
+
+        while (!Q.Rays.empty() && !IsToBeStop)
+        {
+          // Intersect rays stream and compact hits
+          Q.Hits.clear();
+          if (WaveSort & WAVE_SORT_OCTANT)
+            Sort(Q.Rays.size(), [&]( INT i ){ return Octant(Q.Rays[i].R); });
+          for (UINT_PTR k = 0; k < Q.Rays.size(); k++)
+          {
+            INT i = (WaveSort & WAVE_SORT_OCTANT) ? Q.Order[k] : (INT)k;
+            wave_ray &Wr = Q.Rays[i];
+            intr in;
+            REAL TMax = Wr.Level < MaxRecLevel ? FogDistance(Wr.R, Wr.Dist) : -1;
+
+            if (TMax >= 0 && TMax <= Threshold)
+              Q.Colors[Wr.Sample] += Wr.Thr * FogColor;
+            else if (Wr.Level < MaxRecLevel && Intersect(Wr.R, &in, nullptr, nullptr, TMax))
+              Q.Hits.push_back({i, in});
+            else if (Wr.Level >= MaxRecLevel)
+            {
+              KilledByDepth.fetch_add(1, std::memory_order_relaxed);
+              Q.Colors[Wr.Sample] += Wr.Thr * BackgroundColor;
+            }
+            else
+              Q.Colors[Wr.Sample] += Wr.Thr * Fog(Wr.R, -1, BackgroundColor, Wr.Dist);
+          }
+          if (WaveSort & WAVE_SORT_SHAPE)
+            std::stable_sort(Q.Hits.begin(), Q.Hits.end(),
+              []( const wave_hit &A, const wave_hit &B )
+              {
+                return A.In.Shp != B.In.Shp ? A.In.Shp < B.In.Shp : A.In.M < B.In.M;
+              });
+
+          // Shade hits: local lighting, shadow and reflection rays generation
+          Q.Shadows.clear();
+          Q.NextRays.clear();
+          for (auto &H : Q.Hits)
+          {
+            const wave_ray &Wr = Q.Rays[H.Ray];
+            intr *In = &H.In;
+            ray R1 {Wr.R.Org, Wr.R.Dir};
+
+            In->P = R1(In->T);
+            In->N.Normalize();
+            SetDifferentials(Wr.R, Wr.Diff, In);
+
+            vec3 Thr = Wr.Thr * exp(-In->T * Air.Decay);
+
+            // Fog: fogged part of segment is added at once, the rest scales path throughput
+            if (FogMode != FOG_NONE)
+            {
+              REAL f = exp(-FogDepth(Wr.R, In->T, Wr.Dist));
+
+              Q.Colors[Wr.Sample] += Wr.Thr * FogColor * (1 - f);
+              Thr *= f;
+            }
+            const surface &Surf = In->Shp->Surf;
+            vec3 N = In->N, V = R1.Dir;
+
+            if ((V & N) > 0)
+              N = -N;
+            if (IsDenoise && Wr.Level == 0)
+              Q.Aux[Wr.Sample / n].Add(N, In->T, In->Shp->IsUsingMod ? In->Shp->Mode(In->P, N, In) : Surf.Kd);
+            Q.Colors[Wr.Sample] += Thr * (Surf.Ka * AmbientColor);
+
+            vec3 R = (V - N * (2 * (V & N))).Normalizing();
+
+            for (INT i : LightGrid.Get(In->P))
+            {
+              if (!LightGrid.IsInfluence(i, In->P))
+                continue;
+              light_info li;
+              REAL sh = Lights[i]->Shadow(In->P, &li);
+              li.L.Normalize();
+              if (IsAttenuation)
+                li.Color *= sh;
+
+              REAL nl = N & li.L;
+
+              if (nl <= Threshold)
+                continue;
+
+              // Area lights visibility is sampled here (adaptively), stream keeps point lights rays
+              REAL vis = 1;
+
+              if (Lights[i]->SamplesSide > 1)
+              {
+                INT p = Wr.Sample / n;
+
+                vis = LightVisibility(In->P, i, li, {T.X0 + p % T.W, T.Y0 + p / T.W, Wr.Sample % n, n}, Wr.Level);
+                if (vis <= 0)
+                  continue;
+                li.Color *= vis;
+              }
+              vec3 c;
+
+              if (In->Shp->IsUsingMod)
+                c = In->Shp->Mode(In->P, N, In) * li.Color * nl;
+              else
+                c = Surf.Kd * li.Color * nl;
+              if (REAL rl = R & li.L; rl > Threshold)
+                c += Surf.Ks * li.Color * pow(rl, Surf.Ph);
+              Q.Shadows.push_back({ray(In->P + li.L * RayOffset, li.L),
+                                   Lights[i]->SamplesSide > 1 ? -1 : li.Dist, Thr * c, Wr.Sample, i});
+            }
+
+            if (Surf.Kr.IsUsage)
+            {
+              INT p = Wr.Sample / n;
+              REAL w = Surf.Kr.MaxComponent() * Wr.Weight,
+                s = Survive(w, Wr.Level + 1, {T.X0 + p % T.W, T.Y0 + p / T.W, Wr.Sample % n, n});
+
+              if (s > 0)
+                Q.NextRays.push_back({ray(In->P + R * RayOffset, R), Thr * Surf.Kr.K * s, w * s, Wr.Level + 1, Wr.Sample,
+                                      Wr.Diff.Reflect(N, In->dPdx, In->dPdy), Wr.Dist + In->T});
+            }
+          }
+
+          // Trace shadow rays stream
+          Q.IsLit.assign(Q.Shadows.size(), FALSE);
+          if (WaveSort & WAVE_SORT_OCTANT)
+            Sort(Q.Shadows.size(), [&]( INT i ){ return Octant(Q.Shadows[i].R); });
+          for (UINT_PTR k = 0; k < Q.Shadows.size(); k++)
+          {
+            INT i = (WaveSort & WAVE_SORT_OCTANT) ? Q.Order[k] : (INT)k;
+
+            Q.IsLit[i] = Q.Shadows[i].Dist < 0 ||
+              !IsOccluded(Q.Shadows[i].R, Q.Shadows[i].Dist, Q.Shadows[i].Light);
+          }
+          // Accumulate in generation order (result does not depend on sorting)
+          for (UINT_PTR i = 0; i < Q.Shadows.size(); i++)
+            if (Q.IsLit[i])
+              Q.Colors[Q.Shadows[i].Sample] += Q.Shadows[i].Color;
+
+          std::swap(Q.Rays, Q.NextRays);
+        }
+
+        for (INT p = 0; p < T.W * T.H; p++)
+        {
+          vec3 c;
+
+          for (INT k = 0; k < n; k++)
+            c += Q.Colors[(UINT_PTR)p * n + k];
+          c /= n;
+          Buf[p] = frame::ToRGB(c.X, c.Y, c.Z);
+          if (IsDenoise)
+            Aux.Put(T.X0 + p % T.W, T.Y0 + p / T.W, c, Q.Aux[p], n);
+        }
+      } /* End of 'RenderTileWavefront' function */
+
+      /* Render tile in reduced resolution to buffer function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - tile:
+       *       const tile &T;
+       *   - destination buffer (T.W * T.H pixels, row by row):
+       *       DWORD *Buf;
+       *   - pixels block side (one ray per block, block is filled by its color):
+       *       INT Block;
+       * RETURNS: None.
+       */
+      VOID RenderTileBlocks( const camera &Cam, const tile &T, DWORD *Buf, INT Block )
+      {
+        for (INT by = 0; by < T.H; by += Block)
+          for (INT bx = 0; bx < T.W; bx += Block)
+          {
+            ray r = PrimaryRay(Cam, T.X0 + bx + Block * 0.5, T.Y0 + by + Block * 0.5, &CurDiff);
+
+            CurPath = {T.X0 + bx, T.Y0 + by, 0, 1};
+            vec3 c = Trace(r, Air, 1);
+            DWORD Color = frame::ToRGB(c.X, c.Y, c.Z);
+            INT
+              w = bx + Block > T.W ? T.W - bx : Block,
+              h = by + Block > T.H ? T.H - by : Block;
+
+            for (INT y = 0; y < h; y++)
+              for (INT x = 0; x < w; x++)
+                Buf[(by + y) * T.W + bx + x] = Color;
+          }
+      } /* End of 'RenderTileBlocks' function */
+
+      /* Render tiles subset function.
        * ARGUMENTS:
        *   - camera:
        *       const camera &Cam;
        *   - frame:
        *       frame &Frm;
+       *   - first tile number and step between rendered tiles:
+       *       INT First, Step;
        *   - is debug mode flag:
        *       BOOL IsDebug = FALSE;
-       * RETURNS: None.
+       *   - pixels block side for reduced resolution render (1 - full resolution):
+       *       INT Block = 1;
+       *   - stored tile callback (called from render threads):
+       *       const std::function<VOID( const tile & )> &OnTile = nullptr;
+       *   - tiles numbers list (First and Step select from it, nullptr - all tiles):
+       *       const std::vector<INT> *List = nullptr;
+       * RETURNS:
+       *   (BOOL) TRUE if all tiles rendered, FALSE if render was stopped.
        */
-      VOID Render( const camera &Cam, frame &Frm, BOOL IsDebug = FALSE )
+      BOOL RenderTiles( const camera &Cam, frame &Frm, INT First, INT Step, BOOL IsDebug = FALSE, INT Block = 1,
+                        const std::function<VOID( const tile & )> &OnTile = nullptr,
+                        const std::vector<INT> *List = nullptr )
       {
-        INT n = std::thread::hardware_concurrency();
+        INT n = ThreadsCount > 0 ? ThreadsCount : (INT)std::thread::hardware_concurrency();
+        if (n < 1)
+          n = 1;
         if (IsDebug) // For debug mode, render with one thread (for render checking)
           n = 1;
 
-        std::vector<std::thread> Ths;
-        Ths.resize(n);
+        // Reduced resolution tiles have the same rays count as full resolution ones
+        tile_grid Grid(Frm.W, Frm.H, TileSize * Block);
+        BOOL IsPrimaryCache = IsGBuffer || IsRelight;
+
+        if (Block > 1)
+          IsPrimaryCache = FALSE;
+        else if (IsGBuffer && !IsRelight)
+        {
+          GBufferW = Frm.W;
+          GBufferH = Frm.H;
+          GBufferSamples = SampleGrid > 0 ? SampleGrid * SampleGrid : 1;
+          GBuffer.resize((UINT_PTR)GBufferW * GBufferH * GBufferSamples);
+        }
+
+        LightGrid.Build(Lights, IsAttenuation ? LightCutoff : 0);
+        DiffStep = Block > 1 ? Block : 1.0 / (SampleGrid > 0 ? SampleGrid : 1);
+        ShapeBounds.resize(FogMode != FOG_NONE ? Shapes.size() : 0);
+        for (UINT_PTR i = 0; i < ShapeBounds.size(); i++)
+          ShapeBounds[i].IsBounded = Shapes[i]->GetBound(&ShapeBounds[i].Min, &ShapeBounds[i].Max);
+        if (IsDenoise && Block == 1 && (Aux.W != Frm.W || Aux.H != Frm.H))
+          Aux.Resize(Frm.W, Frm.H);
 
-        StartRow = 0;
-        for (INT i = 0; i < n; i++)
+        // References are collected by recursive tracing of full resolution only
+        BOOL IsTrack = IsTrackTiles && Block == 1 && !IsRelight;
+
+        if (IsTrack && (RefsW != Frm.W || RefsH != Frm.H || RefsTileSize != TileSize ||
+                        (INT)TileRefs.size() != Grid.Count()))
         {
-          Ths[i] = std::thread(
-            [&]( VOID )
+          if (List != nullptr)
+            IsTrack = FALSE, TileRefs.clear();
+          else
+          {
+            RefsW = Frm.W;
+            RefsH = Frm.H;
+            RefsTileSize = TileSize;
+            TileRefs.assign(Grid.Count(), tile_refs());
+          }
+        }
+        INT Count = List != nullptr ? (INT)List->size() : Grid.Count();
+
+        Pool.Start(n);
+        StartTile = 0;
+        Pool.Run(
+          [&]( INT )
+          {
+            std::vector<DWORD> Buf((UINT_PTR)Grid.Size * Grid.Size);
+            wave_queues Q;
+            shadow_cache Cache;
+
+            if (IsShadowCache)
+            {
+              Cache.Occluders.assign(Lights.size(), -1);
+              CurShadow = &Cache;
+            }
+
+            // Stop flag is checked per tile, unfinished tile is not stored
+            for (INT i; !IsToBeStop && (i = First + StartTile++ * Step) < Count; )
             {
-              INT y = 0;
-              while (y < Frm.H)
+              INT No = List != nullptr ? (*List)[i] : i;
+              tile T = Grid[No];
+
+              if (IsTrack)
+              {
+                CurRefs = &TileRefs[No];
+                CurRefs->Reset((INT)Shapes.size());
+              }
+              if (Block > 1)
+                RenderTileBlocks(Cam, T, Buf.data(), Block);
+              else if (IsWavefront && !IsPrimaryCache && !IsTrack)
+                RenderTileWavefront(Cam, T, Buf.data(), Q);
+              else
+                RenderTile(Cam, T, Buf.data());
+              if (CurRefs != nullptr && IsToBeStop)
+                CurRefs->IsValid = FALSE;
+              CurRefs = nullptr;
+              if (!IsToBeStop)
               {
-                y = StartRow++;
-                for (INT x = 0; x < Frm.W; x++)
-                {
-                  //ray r = Cam.FrameRay(x + 0.5, y + 0.5);
-                  //vec3 c = Trace(r, Air, 0.1);
-                  const INT l = 2;
-                  const DBL s = 1.0 / l;
-
-                  //if (y < Frm.H / 2)// || x < Frm.W / 2)
-                  //  continue;
-                  //if (y == Frm.H / 2 && x == Frm.W / 2)
-                  //  __debugbreak();
-
-                  vec3 c;
-                  
-                  for (INT i = 0; i < l; ++i)
-                    for (INT j = 0; j < l; ++j)
-                    {
-                      ray r = Cam.FrameRay(x + j * s, y + i * s);
-                      c += Trace(r, Air, 0.1);
-                    }
-                  
-                  c /= l * l;
-                  
-                  Frm.PutPixel(x, y, frame::ToRGB(c.X, c.Y, c.Z));
-                }
+                Frm.PutRect(T.X0, T.Y0, T.W, T.H, Buf.data());
+                if (OnTile)
+                  OnTile(T);
               }
-            });
+            }
+            CurShadow = nullptr;
+            ShadowCacheTests.fetch_add(Cache.Tests, std::memory_order_relaxed);
+            ShadowCacheHits.fetch_add(Cache.Hits, std::memory_order_relaxed);
+          });
+        return !IsToBeStop;
+      } /* End of 'RenderTiles' function */
+
+      /* Render scene coarse to fine (1/8, 1/4, 1/2 and full resolution) function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - frame:
+       *       frame &Frm;
+       *   - level finish callback (gets level pixels block side):
+       *       const std::function<VOID( INT )> &OnLevel;
+       *   - first level pixels block side:
+       *       INT FirstBlock = 8;
+       * RETURNS:
+       *   (BOOL) TRUE if all levels rendered, FALSE if render was stopped.
+       */
+      BOOL RenderProgressive( const camera &Cam, frame &Frm,
+                              const std::function<VOID( INT )> &OnLevel, INT FirstBlock = 8 )
+      {
+        for (INT Block = FirstBlock > 1 ? FirstBlock : 1; Block >= 1; Block /= 2)
+        {
+          if (!RenderTiles(Cam, Frm, 0, 1, FALSE, Block))
+            return FALSE;
+          if (OnLevel)
+            OnLevel(Block);
         }
-        for (INT i = 0; i < n; i++)
-          Ths[i].join();
+        return TRUE;
+      } /* End of 'RenderProgressive' function */
+
+      /* Render scene function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - frame:
+       *       frame &Frm;
+       *   - is debug mode flag:
+       *       BOOL IsDebug = FALSE;
+       * RETURNS: None.
+       */
+      VOID Render( const camera &Cam, frame &Frm, BOOL IsDebug = FALSE )
+      {
+        RenderTiles(Cam, Frm, 0, 1, IsDebug);
 
         // Old render, without multithread
 #if 0 
@@ -182,6 +749,297 @@ namespace pirt
 #endif // 0
       } /* End of 'Render' function */
 
+      /* Relight (render from primary hits cache) function.
+       * ARGUMENTS:
+       *   - camera (the same as at G-buffer render):
+       *       const camera &Cam;
+       *   - frame:
+       *       frame &Frm;
+       * RETURNS:
+       *   (BOOL) TRUE if success, FALSE if G-buffer is not valid for frame or render stopped.
+       * NOTE: Only lights and materials may change after G-buffer render.
+       */
+      BOOL Relight( const camera &Cam, frame &Frm )
+      {
+        if (GBuffer.empty() || GBufferW != Frm.W || GBufferH != Frm.H ||
+            GBufferSamples != (SampleGrid > 0 ? SampleGrid * SampleGrid : 1))
+          return FALSE;
+
+        IsRelight = TRUE;
+        BOOL IsDone = RenderTiles(Cam, Frm, 0, 1);
+        IsRelight = FALSE;
+        return IsDone;
+      } /* End of 'Relight' function */
+
+      /* Denoise last full resolution render function.
+       * ARGUMENTS:
+       *   - frame (the same as at render):
+       *       frame &Frm;
+       * RETURNS:
+       *   (BOOL) TRUE if success, FALSE if guide buffers are not collected or render was stopped.
+       */
+      BOOL Denoise( frame &Frm )
+      {
+        if (!IsDenoise || Aux.W != Frm.W || Aux.H != Frm.H)
+          return FALSE;
+
+        INT n = ThreadsCount > 0 ? ThreadsCount : (INT)std::thread::hardware_concurrency();
+        tile_grid Grid(Frm.W, Frm.H, TileSize);
+
+        // Passes are separated: every pass reads whole previous one result
+        auto Pass =
+          [&]( const std::function<VOID( const tile & )> &Job )
+          {
+            StartTile = 0;
+            Pool.Run(
+              [&]( INT )
+              {
+                for (INT No; !IsToBeStop && (No = StartTile++) < Grid.Count(); )
+                  Job(Grid[No]);
+              });
+          };
+
+        Pool.Start(n < 1 ? 1 : n);
+        Denoiser.Begin(Aux);
+        Pass([&]( const tile &T ){ Denoiser.Estimate(T); });
+        for (INT i = 0; i < Denoiser.Iterations && !IsToBeStop; i++)
+        {
+          Pass([&]( const tile &T ){ Denoiser.Filter(i, T); });
+          Denoiser.EndPass();
+        }
+        if (IsToBeStop)
+          return FALSE;
+        Denoiser.End(Frm);
+        return TRUE;
+      } /* End of 'Denoise' function */
+
+      /* Get shape world space bound box function.
+       * ARGUMENTS:
+       *   - shape:
+       *       shape *Shp;
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      static BOOL WorldBound( shape *Shp, vec3 *Min, vec3 *Max )
+      {
+        vec3 B0, B1;
+
+        if (!Shp->GetBound(&B0, &B1))
+          return FALSE;
+        const matr &M = Shp->GetMatr();
+        for (INT i = 0; i < 8; i++)
+        {
+          vec3 P = M.TransformPoint(vec3(i & 1 ? B1.X : B0.X, i & 2 ? B1.Y : B0.Y, i & 4 ? B1.Z : B0.Z));
+
+          if (i == 0)
+            *Min = *Max = P;
+          *Min = vec3((std::min)(Min->X, P.X), (std::min)(Min->Y, P.Y), (std::min)(Min->Z, P.Z));
+          *Max = vec3((std::max)(Max->X, P.X), (std::max)(Max->Y, P.Y), (std::max)(Max->Z, P.Z));
+        }
+        return TRUE;
+      } /* End of 'WorldBound' function */
+
+      /* Get frame tiles which may change after shape edit function.
+       * ARGUMENTS:
+       *   - camera (the same as at tracked render):
+       *       const camera &Cam;
+       *   - edited (moved, changed, removed) shape:
+       *       shape *Shp;
+       * RETURNS:
+       *   (std::vector<INT>) tiles numbers.
+       * NOTE: Tile is dirty if its rays hit the shape before edit or
+       *       may reach shape new bound box (by primary rays projection
+       *       or by secondary and shadow rays bounds). Call after edit.
+       */
+      std::vector<INT> DirtyTiles( const camera &Cam, shape *Shp )
+      {
+        tile_grid Grid(RefsW, RefsH, RefsTileSize);
+        std::vector<INT> List;
+        INT ShpNo = (INT)(std::find(Shapes.begin(), Shapes.end(), Shp) - Shapes.begin());
+        vec3 Min, Max;
+        BOOL IsAll =
+          TileRefs.empty() || (INT)TileRefs.size() != Grid.Count() ||
+          RefsW != Cam.FrameW || RefsH != Cam.FrameH ||
+          ShpNo >= (INT)Shapes.size() || !WorldBound(Shp, &Min, &Max);
+        REAL X0 = 0, Y0 = 0, X1 = RefsW, Y1 = RefsH;
+
+        // Bound box screen rectangle (whole frame if box is not before near plane)
+        if (!IsAll)
+        {
+          BOOL IsFirst = TRUE;
+
+          for (INT i = 0; i < 8; i++)
+          {
+            vec3 V = vec3(i & 1 ? Max.X : Min.X, i & 2 ? Max.Y : Min.Y, i & 4 ? Max.Z : Min.Z) - Cam.Loc;
+            REAL z = V & Cam.Dir;
+
+            if (z <= Cam.ProjDist)
+            {
+              X0 = Y0 = 0, X1 = RefsW, Y1 = RefsH;
+              break;
+            }
+            REAL
+              Xs = (V & Cam.Right) * Cam.ProjDist / z * RefsW / Cam.Wp + RefsW / 2.0,
+              Ys = RefsH / 2.0 - (V & Cam.Up) * Cam.ProjDist / z * RefsH / Cam.Hp;
+
+            if (IsFirst)
+              X0 = X1 = Xs, Y0 = Y1 = Ys, IsFirst = FALSE;
+            X0 = (std::min)(X0, Xs), X1 = (std::max)(X1, Xs);
+            Y0 = (std::min)(Y0, Ys), Y1 = (std::max)(Y1, Ys);
+          }
+          X0 -= 1, Y0 -= 1, X1 += 1, Y1 += 1;
+        }
+
+        for (INT No = 0; No < Grid.Count(); No++)
+        {
+          if (!IsAll)
+          {
+            tile T = Grid[No];
+            const tile_refs &Refs = TileRefs[No];
+
+            if (Refs.IsValid && (INT)Refs.Shapes.size() == (INT)Shapes.size() &&
+                !Refs.IsTouched(ShpNo) && !Refs.IsReachable(Min, Max) &&
+                (T.X0 + T.W < X0 || T.X0 > X1 || T.Y0 + T.H < Y0 || T.Y0 > Y1))
+              continue;
+          }
+          List.push_back(No);
+        }
+        return List;
+      } /* End of 'DirtyTiles' function */
+
+      /* Render only specified tiles (with tracked references update) function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - frame (keeps other tiles):
+       *       frame &Frm;
+       *   - tiles numbers:
+       *       const std::vector<INT> &List;
+       * RETURNS:
+       *   (BOOL) TRUE if all tiles rendered, FALSE if render was stopped.
+       */
+      BOOL RenderTileList( const camera &Cam, frame &Frm, const std::vector<INT> &List )
+      {
+        return RenderTiles(Cam, Frm, 0, 1, FALSE, 1, nullptr, &List);
+      } /* End of 'RenderTileList' function */
+
+      /* Trace primary ray with storing hit function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray &R;
+       *   - hit to be stored (Shp is nullptr if no hit):
+       *       intr *Hit;
+       * RETURNS:
+       *   (vec3) color, the same as 'Trace(R, Air, 1)'.
+       */
+      vec3 TracePrimary( const ray &R, intr *Hit )
+      {
+        Hit->Shp = nullptr;
+        if (IsToBeStop)
+          return vec3(0);
+        if (MaxRecLevel <= 0)
+          return BackgroundColor;
+        if (!Intersect(R, Hit, nullptr, nullptr, FogDistance(R, 0)))
+        {
+          Hit->Shp = nullptr;
+          return Fog(R, -1, BackgroundColor, 0);
+        }
+
+        ray R1 {R.Org, R.Dir};
+
+        Hit->P = R1(Hit->T);
+        Hit->N.Normalize();
+        SetDifferentials(R, CurDiff, Hit);
+        return TraceCached(R, *Hit);
+      } /* End of 'TracePrimary' function */
+
+      /* Trace primary ray by stored hit function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray &R;
+       *   - stored hit:
+       *       const intr &Hit;
+       * RETURNS:
+       *   (vec3) color.
+       */
+      vec3 TraceCached( const ray &R, const intr &Hit )
+      {
+        if (IsToBeStop)
+          return vec3(0);
+        if (Hit.Shp == nullptr)
+          return Fog(R, -1, BackgroundColor, 0);
+
+        // Shading may change intersection payload, so work with copy
+        intr in = Hit;
+        ray R1 {R.Org, R.Dir};
+
+        CurPathDist = Hit.T;
+        vec3 color = Shade(R1.Dir, Air, &in, 1, 1);
+        CurPathDist = 0;
+
+        color *= exp(-in.T * Air.Decay);
+        return Fog(R, Hit.T, color, 0);
+      } /* End of 'TraceCached' function */
+
+      /* Secondary (reflected or transmitted) path continuation function.
+       * ARGUMENTS:
+       *   - path weight (throughput maximal component) after bounce:
+       *       REAL Weight;
+       *   - bounces count:
+       *       INT Level;
+       *   - path sample:
+       *       const path_sample &Ps;
+       * RETURNS:
+       *   (REAL) continued path contribution scale (1 / survival probability), 0 if path is terminated.
+       */
+      REAL Survive( REAL Weight, INT Level, const path_sample &Ps )
+      {
+        if (!IsRoulette)
+        {
+          if (Weight > MinThroughput)
+            return 1;
+          KilledByThroughput.fetch_add(1, std::memory_order_relaxed);
+          return 0;
+        }
+        if (Level < RouletteDepth || Weight >= RouletteThreshold)
+          return 1;
+
+        // Survived path keeps the same expected contribution
+        REAL p = Weight / RouletteThreshold;
+        // Survival number is hashed by path (not sampled): grid samples repeat in every pixel and bounce
+        DWORD h = sampler::Hash(Sampler.StreamHash(Ps.X, Ps.Y, 2 + Level) ^ sampler::Hash((DWORD)Ps.No));
+
+        if (h * (1.0 / 4294967296.0) < p)
+          return 1 / p;
+        KilledByRoulette.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+      } /* End of 'Survive' function */
+
+      /* Reset path termination and shadow cache counters function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID ResetPathCounters( VOID )
+      {
+        KilledByDepth = KilledByThroughput = KilledByRoulette = 0;
+        ShadowCacheTests = ShadowCacheHits = 0;
+        AreaShadowRays = AreaShadowSkipped = 0;
+      } /* End of 'ResetPathCounters' function */
+
+      /* Get shadow cache hit rate function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (REAL) hits count to tests count ratio (0 if no tests).
+       */
+      REAL ShadowCacheHitRate( VOID ) const
+      {
+        UINT64 Tests = ShadowCacheTests;
+
+        return Tests == 0 ? 0 : (REAL)ShadowCacheHits / Tests;
+      } /* End of 'ShadowCacheHitRate' function */
+
       /* Trace function.
        * ARGUMENTS:
        *   - ray:
@@ -189,13 +1047,13 @@ namespace pirt
        *   - enviroment:
        *       const envi &Media;
        *   - weight:
-       *       DBL Weight;
+       *       REAL Weight;
        *   - recurse level:
        *       INT RecLevel;
        * RETURNS:
        *   (vec3) color.
        */
-      vec3 Trace( const ray &R, const envi &Media, DBL Weight, INT RecLevel = 0 )
+      vec3 Trace( const ray &R, const envi &Media, REAL Weight, INT RecLevel = 0 )
       {
         intr in;
 
@@ -206,23 +1064,42 @@ namespace pirt
 #if 1
         if (RecLevel < MaxRecLevel)
         {
+          REAL Dist = CurPathDist, TMax = FogDistance(R, Dist);
+
+          // Fully fogged ray (e.g. reflected inside fog) is not traced
+          if (TMax >= 0 && TMax <= Threshold)
+            return FogColor;
           ++RecLevel;
-          if (Intersect(R, &in))
+          if (Intersect(R, &in, nullptr, nullptr, TMax))
           {
             const matr &InvMatr = in.Shp->GetInvMatr();
             const matr &Matr = in.Shp->GetMatr();
             ray R1 {R.Org, R.Dir}; // InvMatr.TransformPoint(R.Org), InvMatr.TransformVector(R.Dir)
 
             in.P = R1(in.T);
+            if (CurRefs != nullptr && RecLevel > 1)
+              CurRefs->AddSegment(R.Org, in.P);
             //in.Shp->GetNormal(&in);
             in.N.Normalize();
+            SetDifferentials(R, CurDiff, &in);
 
+            CurPathDist = Dist + in.T;
             color = Shade(R1.Dir, Media, &in, Weight, RecLevel);
+            CurPathDist = Dist;
             //color = Shade(in.P, Media, &in, Weight);
             color *= exp(-in.T * Media.Decay);
+            color = Fog(R, in.T, color, Dist);
+          }
+          else
+          {
+            if (CurRefs != nullptr && RecLevel > 1)
+              CurRefs->AddEscape(R);
+            color = Fog(R, -1, color, Dist);
           }
           --RecLevel;
         }
+        else
+          KilledByDepth.fetch_add(1, std::memory_order_relaxed);
         return color;
 #else  // 0
 //        vec3 color;
@@ -248,28 +1125,30 @@ namespace pirt
        *   - intersection:
        *       intr *In;
        *   - weight:
-       *       DBL Weight;
+       *       REAL Weight;
        *   - recurse level:
        *       INT RecLevel;
        * RETURNS:
        *   (vec3) color.
        */
-      vec3 Shade( const vec3 &V, const envi &Media, intr *In, DBL Weight, INT RecLevel )
+      vec3 Shade( const vec3 &V, const envi &Media, intr *In, REAL Weight, INT RecLevel )
       {
-        shade_info si {In->P, In->N, In->Shp, In->Shp->Surf, Media, {1, 0, 0}, {0, 1, 0}, In};
+        shade_info si {In->P, In->N, In->Shp, &In->Shp->Surf, Media, {1, 0, 0}, {0, 1, 0}, In};
           /// modifiers (later)
           // face forward (si.N):
         // Faceforward normal
-        DBL vn = V & si.N;
+        REAL vn = V & si.N;
 
         if (vn > 0)
         {
           si.N = -si.N;
           vn = -vn;
-          //DBL vn = V & si.N;
+          //REAL vn = V & si.N;
           BOOL IsEnter = TRUE;
           IsEnter = FALSE;
         }
+        if (CurAux != nullptr && RecLevel == 1)
+          CurAux->Add(si.N, In->T, si.Shp->IsUsingMod ? si.Shp->Mode(si.P, si.N, si.In) : si.Surf->Kd);
 
 #if 0
         vec3 N = In->N;
@@ -280,8 +1159,8 @@ namespace pirt
         // Material #1 - segmented field
         if (In->M == 1)
         {
-          DBL X = In->P.X;
-          DBL Z = In->P.Z;
+          REAL X = In->P.X;
+          REAL Z = In->P.Z;
           BOOL flag = true;
 
           if (X < 0)
@@ -324,38 +1203,53 @@ namespace pirt
         return diffuse;
 #endif
         // Ambient
-        vec3 color = si.Surf.Ka * AmbientColor;
+        vec3 color = si.Surf->Ka * AmbientColor;
         vec3 R = (V - si.N * (2 * (V & si.N))).Normalizing();
 
-        for (auto Lgh : Lights)
+        for (INT i : LightGrid.Get(si.P))
         {
+          if (!LightGrid.IsInfluence(i, si.P))
+            continue;
           light_info li;
-          DBL sh = Lgh->Shadow(si.P, &li);
-          intr il;
+          REAL sh = Lights[i]->Shadow(si.P, &li);
           li.L.Normalize();
-          if (Intersect(ray(si.P + li.L * Threshold, li.L), &il) > 0 &&
-              il.T < li.Dist)
+          if (IsAttenuation)
+            li.Color *= sh;
+          REAL nl = si.N & li.L;
+
+          if (nl <= Threshold)
+            continue;
+          REAL vis = LightVisibility(si.P, i, li, CurPath, RecLevel - 1);
+
+          if (vis <= 0)
             continue; // point in shadow
-          DBL nl = si.N & li.L;
+          li.Color *= vis;
 
           // diffuse
-          if (nl > Threshold)
-          {
-            if (si.Shp->IsUsingMod)
-              color += si.Shp->Mode(si.P, si.N, si.In) * li.Color * nl;
-            else
-              color += si.Surf.Kd * li.Color * nl; // ??? * sh
+          if (si.Shp->IsUsingMod)
+            color += si.Shp->Mode(si.P, si.N, si.In) * li.Color * nl;
+          else
+            color += si.Surf->Kd * li.Color * nl; // ??? * sh
 
-            // specular
-            if (DBL rl = R & li.L; rl > Threshold)
-              color += si.Surf.Ks * li.Color * pow(rl, si.Surf.Ph); // ??? * sh
-          }
+          // specular
+          if (REAL rl = R & li.L; rl > Threshold)
+            color += si.Surf->Ks * li.Color * pow(rl, si.Surf->Ph); // ??? * sh
         }
 
         // Reflection other scene shapes
-        if (DBL w = si.Surf.Kr.MaxComponent() * Weight; w > ColorThresold)
-          // OR si.Surf.Kr.IsUsage && coef(si.Surf.Kr.K * Weight).IsUsage
-          color += si.Surf.Kr.K * Trace(ray(si.P + R * Threshold, R), Media, w, RecLevel);
+        if (si.Surf->Kr.IsUsage)
+        {
+          REAL w = si.Surf->Kr.MaxComponent() * Weight, s = Survive(w, RecLevel, CurPath);
+
+          if (s > 0)
+          {
+            ray_diff Diff = CurDiff;
+
+            CurDiff = Diff.Reflect(si.N, In->dPdx, In->dPdy);
+            color += si.Surf->Kr.K * s * Trace(ray(si.P + R * RayOffset, R), Media, w * s, RecLevel);
+            CurDiff = Diff;
+          }
+        }
 
         return color;
       } /* End of 'Shade function' */
@@ -368,16 +1262,24 @@ namespace pirt
        *       intr *In;
        *   - current shape for shade (nullptr if no):
        *       shape *cur
+       *   - intersected shape number to be set (nullptr if not needed):
+       *       INT *ShpNo = nullptr;
+       *   - maximal ray parameter (negative if not limited, shapes bounds beyond it are skipped):
+       *       REAL TMax = -1;
        * RETURNS:
        *   (BOOL) status of intersection.
        */
-      BOOL Intersect( const ray &R, intr *In, shape *cur = nullptr )
+      BOOL Intersect( const ray &R, intr *In, shape *cur = nullptr, INT *ShpNo = nullptr, REAL TMax = -1 )
       {
+        BOOL IsLimited = TMax >= 0 && ShapeBounds.size() == Shapes.size();
+
         intr best_intr;
+        INT best_no = -1;
         best_intr.T = -1;
 
-        for (auto *shp : Shapes)
+        for (INT i = 0; i < (INT)Shapes.size(); i++)
         {
+          shape *shp = Shapes[i];
           const matr &m1 = shp->GetMatr();
           const matr &m1inv = shp->GetInvMatr();
 
@@ -385,6 +1287,9 @@ namespace pirt
 
           if (shp == cur)
             continue;
+          if (IsLimited && ShapeBounds[i].IsBounded &&
+              BoxEntry(R1, ShapeBounds[i].Min, ShapeBounds[i].Max) > (best_intr.T == -1 ? TMax : best_intr.T))
+            continue;
 
           intr current_intr;
 
@@ -394,15 +1299,315 @@ namespace pirt
             current_intr.N = m1.TransformVector(current_intr.N);
 
             if (best_intr.T == -1 || current_intr.T < best_intr.T)
-              best_intr = current_intr, best_intr.M = shp->material;
+              best_intr = current_intr, best_intr.M = shp->material, best_no = i;
           }
         }
-        if (best_intr.T == -1)
+        if (best_intr.T == -1 || (IsLimited && best_intr.T > TMax))
           return FALSE;
+        if (CurRefs != nullptr)
+          CurRefs->AddShape(best_no);
+        if (ShpNo != nullptr)
+          *ShpNo = best_no;
         *In = best_intr;
         return TRUE;
       } /* End of 'Intersect' function */
 
+      /* Get primary ray with differentials function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera &Cam;
+       *   - frame coordinates:
+       *       REAL Xs, Ys;
+       *   - ray differentials (by samples step, zero if not traced) to be set:
+       *       ray_diff *Diff;
+       * RETURNS:
+       *   (ray) primary ray.
+       */
+      ray PrimaryRay( const camera &Cam, REAL Xs, REAL Ys, ray_diff *Diff ) const
+      {
+        if (!IsRayDiff)
+        {
+          *Diff = ray_diff();
+          return Cam.FrameRay(Xs, Ys);
+        }
+        ray R = Cam.FrameRay(Xs, Ys, Diff);
+
+        *Diff = Diff->Scaled(DiffStep);
+        return R;
+      } /* End of 'PrimaryRay' function */
+
+      /* Set hit point differentials and footprint function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray &R;
+       *   - ray differentials:
+       *       const ray_diff &Diff;
+       *   - hit (with normalized normal):
+       *       intr *In;
+       * RETURNS: None.
+       */
+      static VOID SetDifferentials( const ray &R, const ray_diff &Diff, intr *In )
+      {
+        Diff.Transfer(R, In->T, In->N, &In->dPdx, &In->dPdy);
+        In->Footprint = sqrt((std::max)(In->dPdx.Len2(), In->dPdy.Len2()));
+      } /* End of 'SetDifferentials' function */
+
+      /* Ray entry to box parameter evaluation function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray &R;
+       *   - box:
+       *       const vec3 &Min, &Max;
+       * RETURNS:
+       *   (REAL) entry parameter (0 if ray starts inside, infinity if box is missed).
+       */
+      static REAL BoxEntry( const ray &R, const vec3 &Min, const vec3 &Max )
+      {
+        REAL T0 = 0, T1 = std::numeric_limits<REAL>::infinity();
+        const REAL O[3] {R.Org.X, R.Org.Y, R.Org.Z}, D[3] {R.Dir.X, R.Dir.Y, R.Dir.Z},
+          B0[3] {Min.X, Min.Y, Min.Z}, B1[3] {Max.X, Max.Y, Max.Z};
+
+        for (INT a = 0; a < 3; a++)
+        {
+          if (fabs(D[a]) < 1e-30)
+          {
+            if (O[a] < B0[a] || O[a] > B1[a])
+              return std::numeric_limits<REAL>::infinity();
+            continue;
+          }
+          REAL Ta = (B0[a] - O[a]) / D[a], Tb = (B1[a] - O[a]) / D[a];
+
+          if (Ta > Tb)
+            std::swap(Ta, Tb);
+          T0 = (std::max)(T0, Ta);
+          T1 = (std::min)(T1, Tb);
+          if (T0 > T1)
+            return std::numeric_limits<REAL>::infinity();
+        }
+        return T0;
+      } /* End of 'BoxEntry' function */
+
+      /* Fog optical depth along ray segment evaluation function.
+       * ARGUMENTS:
+       *   - ray (direction is normalized):
+       *       const ray &R;
+       *   - segment length (negative for infinite ray):
+       *       REAL T;
+       *   - path distance to ray origin (secondary segments continue path fog):
+       *       REAL Dist;
+       * RETURNS:
+       *   (REAL) optical depth (infinity if segment is fully fogged).
+       */
+      REAL FogDepth( const ray &R, REAL T, REAL Dist ) const
+      {
+        const REAL Inf = std::numeric_limits<REAL>::infinity();
+        REAL S0 = (std::max)(Dist, FogStart), Len = T < 0 ? Inf : Dist + T - S0;
+
+        if (Len <= 0)
+          return 0;
+        switch (FogMode)
+        {
+        case FOG_LINEAR:
+          // Transmittance falls linearly by path distance, depth is logarithm of segment end to start ratio
+          if (T < 0 || Dist + T >= FogEnd || FogEnd <= FogStart)
+            return Inf;
+          return -log((FogEnd - Dist - T) / (FogEnd - S0));
+        case FOG_EXP:
+          return FogDensity * Len;
+        case FOG_HEIGHT:
+          {
+            // Integral of Density * exp(-Falloff * (y - Height)) along ray from start point
+            REAL
+              y0 = R.Org.Y + R.Dir.Y * (S0 - Dist) - FogHeight,
+              A = FogDensity * exp((std::min)(-FogFalloff * y0, (REAL)50)),
+              k = FogFalloff * R.Dir.Y;
+
+            if (fabs(k) < 1e-8)
+              return A * Len;
+            if (Len == Inf)
+              return k > 0 ? A / k : Inf;
+            return A * (1 - exp((std::max)(-k * Len, (REAL)-700))) / k;
+          }
+        default:
+          return 0;
+        }
+      } /* End of 'FogDepth' function */
+
+      /* Fog saturation (transmittance falls below cut off) distance evaluation function.
+       * ARGUMENTS:
+       *   - ray (direction is normalized):
+       *       const ray &R;
+       *   - path distance to ray origin:
+       *       REAL Dist;
+       * RETURNS:
+       *   (REAL) distance along ray (negative if ray is never fully fogged).
+       */
+      REAL FogDistance( const ray &R, REAL Dist ) const
+      {
+        const REAL D = -log(FogCutoff);
+        REAL T0 = (std::max)(FogStart - Dist, (REAL)0);
+
+        switch (FogMode)
+        {
+        case FOG_LINEAR:
+          return (std::max)(FogStart + (FogEnd - FogStart) * (1 - FogCutoff) - Dist, (REAL)0);
+        case FOG_EXP:
+          return FogDensity > 0 ? (std::max)(FogStart + D / FogDensity - Dist, (REAL)0) : -1;
+        case FOG_HEIGHT:
+          {
+            // Density depends on segment heights, so cut off is by this segment only
+            REAL
+              y0 = R.Org.Y + R.Dir.Y * T0 - FogHeight,
+              A = FogDensity * exp((std::min)(-FogFalloff * y0, (REAL)50)),
+              k = FogFalloff * R.Dir.Y;
+
+            if (A <= 0)
+              return -1;
+            if (fabs(k) < 1e-8)
+              return T0 + D / A;
+            if (REAL q = 1 - D * k / A; q > 0)
+              return T0 - log(q) / k;
+            return -1;
+          }
+        default:
+          return -1;
+        }
+      } /* End of 'FogDistance' function */
+
+      /* Apply fog to ray segment color function.
+       * ARGUMENTS:
+       *   - ray (direction is normalized):
+       *       const ray &R;
+       *   - segment length (negative for infinite ray):
+       *       REAL T;
+       *   - color at segment end:
+       *       const vec3 &Color;
+       *   - path distance to ray origin:
+       *       REAL Dist;
+       * RETURNS:
+       *   (vec3) fogged color.
+       */
+      vec3 Fog( const ray &R, REAL T, const vec3 &Color, REAL Dist ) const
+      {
+        if (FogMode == FOG_NONE)
+          return Color;
+
+        REAL f = exp(-FogDepth(R, T, Dist));
+
+        return Color * f + FogColor * (1 - f);
+      } /* End of 'Fog' function */
+
+      /* Light visibility from point evaluation function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3 &P;
+       *   - light number:
+       *       INT LightNo;
+       *   - light info (by 'Shadow' function, direction is normalized):
+       *       const light_info &Li;
+       *   - path sample (for samples jitter):
+       *       const path_sample &Ps;
+       *   - bounces count:
+       *       INT Level;
+       * RETURNS:
+       *   (REAL) not occluded light part in [0..1].
+       */
+      REAL LightVisibility( const vec3 &P, INT LightNo, const light_info &Li, const path_sample &Ps, INT Level )
+      {
+        const light *Lgh = Lights[LightNo];
+        INT l = Lgh->SamplesSide, n = l * l, Bits = 0, Lit = 0, k;
+
+        if (l <= 1)
+        {
+          if (CurRefs != nullptr)
+            CurRefs->AddSegment(P, P + Li.L * (Li.Dist + RayOffset));
+          return IsOccluded(ray(P + Li.L * RayOffset, Li.L), Li.Dist, LightNo) ? 0 : 1;
+        }
+        if (CurRefs != nullptr)
+        {
+          vec3 B0, B1;
+
+          // Skipped samples depend on whole light surface
+          Lgh->GetBound(&B0, &B1);
+          CurRefs->AddSegment(P, B0);
+          CurRefs->AddSegment(P, B1);
+        }
+        while ((1 << Bits) < l)
+          Bits++;
+        l = 1 << Bits, n = l * l;
+
+        // Strata are visited in bit reversed Morton order: every first 4^m samples cover whole light
+        DWORD h = Sampler.StreamHash(Ps.X, Ps.Y, (LightNo << 8) + 64 + Level) ^ sampler::Hash((DWORD)Ps.No);
+        INT Early = std::clamp(AreaEarlySamples, 1, n);
+
+        for (k = 0; k < n; k++)
+        {
+          DWORD Cell = 0, m = 0;
+
+          for (INT b = 0; b < 2 * Bits; b++)
+            m |= ((k >> b) & 1) << (2 * Bits - 1 - b);
+          for (INT b = 0; b < Bits; b++)
+            Cell |= ((m >> (2 * b)) & 1) << b | ((m >> (2 * b + 1)) & 1) << (b + Bits);
+
+          DWORD hk = sampler::Hash(h ^ (DWORD)k);
+          vec2 U(((Cell & (l - 1)) + (hk & 0xFFFF) / 65536.0) / l, ((Cell >> Bits) + (hk >> 16) / 65536.0) / l);
+          vec3 D = Lgh->SamplePoint(P, U) - P;
+          REAL Dist = !D;
+
+          if (Dist <= Threshold || !IsOccluded(ray(P + D / Dist * RayOffset, D / Dist), Dist, LightNo))
+            Lit++;
+          if (k + 1 == Early && (Lit == 0 || Lit == Early))
+          {
+            k++;
+            break;
+          }
+        }
+        AreaShadowRays.fetch_add(k, std::memory_order_relaxed);
+        if (k < n)
+          AreaShadowSkipped.fetch_add(n - k, std::memory_order_relaxed);
+        return (REAL)Lit / k;
+      } /* End of 'LightVisibility' function */
+
+      /* Shadow ray occlusion test function.
+       * ARGUMENTS:
+       *   - shadow ray:
+       *       const ray &R;
+       *   - distance to light:
+       *       REAL Dist;
+       *   - light number:
+       *       INT LightNo;
+       * RETURNS:
+       *   (BOOL) TRUE if any shape is hit closer than light, FALSE otherwise.
+       */
+      BOOL IsOccluded( const ray &R, REAL Dist, INT LightNo )
+      {
+        shadow_cache *C = CurShadow;
+        intr il;
+        INT No;
+
+        // Last occluder of the light is tested first (any hit before light is enough)
+        if (C != nullptr && LightNo < (INT)C->Occluders.size())
+          if (No = C->Occluders[LightNo]; No >= 0 && No < (INT)Shapes.size())
+          {
+            const matr &m1inv = Shapes[No]->GetInvMatr();
+
+            C->Tests++;
+            if (Shapes[No]->Intersect(ray(m1inv.TransformPoint(R.Org), m1inv.TransformVector(R.Dir)), &il) &&
+                il.T < Dist)
+            {
+              C->Hits++;
+              if (CurRefs != nullptr)
+                CurRefs->AddShape(No);
+              return TRUE;
+            }
+          }
+        if (!Intersect(R, &il, nullptr, &No) || il.T >= Dist)
+          return FALSE;
+        if (C != nullptr && LightNo < (INT)C->Occluders.size())
+          C->Occluders[LightNo] = No;
+        return TRUE;
+      } /* End of 'IsOccluded' function */
+
       /* Scene elements clear function.
        * ARGUMENTS: None.
        * RETURNS: None.
@@ -5,7 +5,7 @@
 
 /* FILE:        rt_win.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 09.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's window addons functions file.
  * NOTE:        None.
  * 
@@ -30,8 +30,6 @@ namespace pirt
     {
       Camera.SetLocAtUp(vec3(3), vec3(0, 0, 0));
 
-      srand(time(nullptr));
-
       // for (int i = 0; i < 500; ++i)
       // {
       //   vec3 S1 = vec3(rand() % 30 - 15, rand() % 30 - 15, rand() % 30 - 15);
@@ -162,6 +160,8 @@ namespace pirt
     /* Default destructor */
     rt_win::~rt_win()
     {
+      StopPreview();
+      Job.reset();
       Scene.ClearScene();
       //delete[] Scene.Shapes;
       //Scene.Shapes.~vector;
@@ -175,6 +175,7 @@ namespace pirt
      */
     VOID rt_win::Resize( INT NewW, INT NewH )
     {
+      StopPreview();
       Frame.Resize(NewW, NewH);
       Camera.Resize(NewW, NewH);
     } /* End of 'rt_win::Resize' function */
@@ -200,6 +201,135 @@ namespace pirt
       Scene.Render(Camera, Frame);
     } /* End of 'rt_win::Render' function */
 
+    /* Stop (cancel) preview render function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID rt_win::StopPreview( VOID )
+    {
+      if (!PreviewThread.joinable())
+        return;
+      // Render stops at next tile
+      Scene.IsToBeStop = TRUE;
+      PreviewThread.join();
+      Scene.IsToBeStop = FALSE;
+    } /* End of 'rt_win::StopPreview' function */
+
+    /* Restart coarse to fine preview render function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID rt_win::StartPreview( VOID )
+    {
+      StopPreview();
+      PreviewThread = std::thread(
+        [this]( VOID )
+        {
+          if (Scene.RenderProgressive(Camera, Frame,
+                [this]( INT )
+                {
+                  InvalidateRect(hWnd, nullptr, FALSE);
+                }) && Scene.IsDenoise && Scene.Denoise(Frame))
+            InvalidateRect(hWnd, nullptr, FALSE);
+        });
+    } /* End of 'rt_win::StartPreview' function */
+
+    /* Move camera by navigation key function.
+     * ARGUMENTS:
+     *   - pressed key (arrows rotate camera around pivot, PageUp/PageDown zoom):
+     *       WPARAM Key;
+     * RETURNS:
+     *   (BOOL) TRUE if key is navigation one, FALSE otherwise.
+     */
+    BOOL rt_win::Navigate( WPARAM Key )
+    {
+      const DBL Angle = 10;
+      matr M;
+
+      switch (Key)
+      {
+      case VK_LEFT:
+        M = matr::RotateY(-Angle);
+        break;
+      case VK_RIGHT:
+        M = matr::RotateY(Angle);
+        break;
+      case VK_UP:
+        M = matr::Rotate(Angle, Camera.Right);
+        break;
+      case VK_DOWN:
+        M = matr::Rotate(-Angle, Camera.Right);
+        break;
+      case VK_PRIOR:
+        M = matr::Scale(vec3(0.8));
+        break;
+      case VK_NEXT:
+        M = matr::Scale(vec3(1.25));
+        break;
+      default:
+        return FALSE;
+      }
+
+      // Camera is changed only when preview render is stopped
+      StopPreview();
+      Camera.SetLocAtUp(Camera.At + M.TransformVector(Camera.Loc - Camera.At), Camera.At, Camera.Up);
+      return TRUE;
+    } /* End of 'rt_win::Navigate' function */
+
+    /* Start full render job function.
+     * ARGUMENTS:
+     *   - is debug mode flag:
+     *       BOOL IsDebug;
+     * RETURNS: None.
+     */
+    VOID rt_win::StartJob( BOOL IsDebug )
+    {
+      StopPreview();
+      IsJobDebug = IsDebug;
+      std::cout << std::endl << "Start render scene" << std::endl << (IsDebug ? "Debug Mode" : "Release mode") << std::endl;
+      Job = std::make_unique<render_job>(Scene, Camera, Frame, nullptr, IsDebug);
+    } /* End of 'rt_win::StartJob' function */
+
+    /* Show full render job progress and finish it if done function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID rt_win::CheckJob( VOID )
+    {
+      if (Job == nullptr)
+        return;
+
+      if (!Job->IsDone())
+      {
+        DBL Eta = Job->ETA();
+
+        std::cout << std::fixed << std::setprecision(1) << Job->Progress() << "%, ETA " <<
+          (Eta < 0 ? 0 : Eta) << " s    \r";
+        return;
+      }
+
+      DBL tt = Job->Elapsed();
+      INT Seconds = (INT)tt;
+
+      std::cout <<
+        std::fixed << tt <<
+        " :: " << std::setfill('0') << std::setw(2) <<
+                                       Seconds / 60 / 60 <<
+        ":" << std::setfill('0') << std::setw(2) <<
+                                       Seconds / 60 % 60 <<
+        ":" << std::setfill('0') << std::setw(2) <<
+                                       Seconds % 60 << "\r";
+
+      if (Job->Future().get() != nullptr && Scene.IsDenoise && Scene.Denoise(Frame))
+        InvalidateRect(hWnd, nullptr, FALSE);
+
+      // Store image while window continues to work
+      if (Job->Future().get() != nullptr && !IsJobDebug)
+        Frame.AutoSaveTGA("CGSG forever!!!",
+          {Seconds / 60 / 60, Seconds / 60 % 60, Seconds % 60});
+      Job.reset();
+    } /* End of 'rt_win::CheckJob' function */
+
     /* WM_SIZE window message handle function.
       * ARGUMENTS:
       *   - sizing flag (see SIZE_***, like SIZE_MAXIMIZED)
@@ -222,6 +352,7 @@ namespace pirt
     VOID rt_win::OnTimer( INT Id )
     {
       //Render();
+      CheckJob();
       InvalidateRect(hWnd, nullptr, false);
     } /* End of 'rt_win::OnTimer' function */
 
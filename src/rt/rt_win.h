@@ -17,10 +17,12 @@
 #define __rt_win_h_
 
 #include <iostream>
+#include <memory>
 
 #include "win/win.h"
 #include "frame.h"
 #include "rt_scene.h"
+#include "render_job.h"
 
 /* Base project namespace */
 namespace pirt
@@ -35,6 +37,10 @@ namespace pirt
       frame Frame;
       camera Camera;
       scene Scene;
+      std::thread PreviewThread;  // Coarse to fine preview render thread
+      std::unique_ptr<render_job>
+        Job;                      // Current full render job
+      BOOL IsJobDebug = FALSE;    // Current job debug mode flag
 
       /* Default constructor
        * ARGUMENTS:
@@ -60,6 +66,41 @@ namespace pirt
        */
       VOID Render( VOID );
 
+      /* Stop (cancel) preview render function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID StopPreview( VOID );
+
+      /* Restart coarse to fine preview render function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID StartPreview( VOID );
+
+      /* Move camera by navigation key function.
+       * ARGUMENTS:
+       *   - pressed key (arrows rotate camera around pivot, PageUp/PageDown zoom):
+       *       WPARAM Key;
+       * RETURNS:
+       *   (BOOL) TRUE if key is navigation one, FALSE otherwise.
+       */
+      BOOL Navigate( WPARAM Key );
+
+      /* Start full render job function.
+       * ARGUMENTS:
+       *   - is debug mode flag:
+       *       BOOL IsDebug;
+       * RETURNS: None.
+       */
+      VOID StartJob( BOOL IsDebug );
+
+      /* Show full render job progress and finish it if done function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID CheckJob( VOID );
+
       /* WM_TIMER window message handle function.
        * ARGUMENTS:
        *   - specified the timer identifier.
@@ -112,61 +153,36 @@ namespace pirt
        */
       LRESULT OnMessage( UINT Msg, WPARAM wParam, LPARAM lParam ) override
       {
-        static BOOL DEBUG_MODE_PARAM = false;
-
         switch (Msg)
         {
         case WM_KEYDOWN:
           if (wParam == 'R' || wParam == 'D')
           {
-            if (!Scene.IsRenderActive)
+            if (Job == nullptr)
+              StartJob(wParam == 'D');
+          }
+          else if (wParam == 'N')
+          {
+            // Denoise switch is applied to next renders
+            if (Job == nullptr)
             {
-              if (wParam == 'D')
-                DEBUG_MODE_PARAM = TRUE;
-              else
-                DEBUG_MODE_PARAM = FALSE;
-
-              Scene.IsRenderActive = TRUE;
-              Scene.IsToBeStop = FALSE;
-              Scene.IsReadyToFinish = FALSE;
-              std::cout << std::endl << "Start render scene" << std::endl << ((wParam == 'D') ? "Debug Mode" : "Release mode") << std::endl;
-              std::thread Th;
-              Th = std::thread(
-                [&]( VOID )
-                {
-                  LONG tt = clock();
-                  Scene.Render(Camera, Frame, DEBUG_MODE_PARAM);
-                  tt = clock() - tt;
-                  INT Seconds = (INT)((DBL)tt / CLOCKS_PER_SEC);
-
-                  std::cout <<
-                    std::fixed << (DBL)tt / CLOCKS_PER_SEC <<
-                    " :: " << std::setfill('0') << std::setw(2) <<
-                                                   Seconds / 60 / 60 <<
-                    ":" << std::setfill('0') << std::setw(2) <<
-                                                   Seconds / 60 % 60 <<
-                    ":" << std::setfill('0') << std::setw(2) <<
-                                                   Seconds % 60 << "\r";
-                  
-                  if (wParam != 'D')
-                    Frame.AutoSaveTGA("CGSG forever!!!",
-                      {Seconds / 60 / 60, Seconds / 60 % 60, Seconds % 60});
-                  InvalidateRect(hWnd, NULL, FALSE);
-                  UpdateWindow(hWnd);
-                  Scene.IsRenderActive = FALSE;
-                  Scene.IsToBeStop = FALSE;
-                  Scene.IsReadyToFinish = TRUE;
-                });
-              Th.detach();
+              StopPreview();
+              Scene.IsDenoise = !Scene.IsDenoise;
+              StartPreview();
             }
           }
           else if (wParam == VK_ESCAPE)
           {
-            if (!Scene.IsRenderActive)
+            if (Job == nullptr)
+            {
+              StopPreview();
               DestroyWindow(hWnd);
+            }
             else
-              Scene.IsToBeStop = TRUE;
+              Job->Cancel();
           }
+          else if (Job == nullptr && Navigate(wParam))
+            StartPreview();
           return 0;
         }
       return DefWindowProc(hWnd, Msg, wParam, lParam);
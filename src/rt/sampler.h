@@ -0,0 +1,415 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        sampler.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's deterministic samples generator header file.
+ * NOTE:        Every sample value is a pure function of (seed, pixel,
+ *              sample number, dimension), so image does not depend on
+ *              threads order. Dimensions usage:
+ *                0, 1 - sub-pixel offset;
+ *                2 + bounce - Russian roulette;
+ *                64 + bounce + light * 256 - area light samples jitter
+ *                                            (stream hash only);
+ *                other - free for other effects (glossy).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __sampler_h_
+#define __sampler_h_
+
+#include <cmath>
+#include <vector>
+#include <string>
+
+#include "def.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Samples generator class */
+    class sampler
+    {
+    public:
+      /* Samples generation mode */
+      enum MODE
+      {
+        GRID,       // Regular sub-pixel grid (no randomness)
+        RANDOM,     // Hashed white noise
+        STRATIFIED, // Jittered strata in random order
+        HALTON,     // Halton sequence with per-pixel rotation
+        SOBOL,      // Owen-scrambled Sobol sequence
+        BLUE_NOISE  // R2 sequence rotated by blue-noise mask
+      } Mode = GRID;                            // Current mode
+      DWORD Seed = 0;                           // Sequences seed (e.g. frame number)
+
+      /* Get mode by name function.
+       * ARGUMENTS:
+       *   - mode name ("grid", "random", "stratified", "halton", "sobol", "bluenoise"):
+       *       const std::string &Name;
+       *   - mode to be set:
+       *       MODE *M;
+       * RETURNS:
+       *   (BOOL) TRUE if name is known, FALSE otherwise.
+       */
+      static BOOL ModeByName( const std::string &Name, MODE *M )
+      {
+        static const struct
+        {
+          const CHAR *Name;
+          MODE M;
+        } Modes[] =
+        {
+          {"grid", GRID},
+          {"random", RANDOM},
+          {"stratified", STRATIFIED},
+          {"halton", HALTON},
+          {"sobol", SOBOL},
+          {"bluenoise", BLUE_NOISE},
+        };
+
+        for (auto &Md : Modes)
+          if (Name == Md.Name)
+          {
+            *M = Md.M;
+            return TRUE;
+          }
+        return FALSE;
+      } /* End of 'ModeByName' function */
+
+      /* Integer hash function.
+       * ARGUMENTS:
+       *   - value:
+       *       DWORD X;
+       * RETURNS:
+       *   (DWORD) hashed value.
+       */
+      static DWORD Hash( DWORD X )
+      {
+        X ^= X >> 16;
+        X *= 0x7FEB352D;
+        X ^= X >> 15;
+        X *= 0x846CA68B;
+        X ^= X >> 16;
+        return X;
+      } /* End of 'Hash' function */
+
+      /* Get sample stream hash function.
+       * ARGUMENTS:
+       *   - pixel coordinates:
+       *       INT X, Y;
+       *   - dimension:
+       *       INT Dim;
+       * RETURNS:
+       *   (DWORD) stream hash.
+       */
+      DWORD StreamHash( INT X, INT Y, INT Dim ) const
+      {
+        return Hash(Seed ^ Hash((DWORD)X ^ Hash((DWORD)Y ^ Hash((DWORD)Dim))));
+      } /* End of 'StreamHash' function */
+
+      /* Get 1D sample function.
+       * ARGUMENTS:
+       *   - pixel coordinates:
+       *       INT X, Y;
+       *   - sample number and samples count in pixel:
+       *       INT SampleNo, Count;
+       *   - dimension:
+       *       INT Dim;
+       * RETURNS:
+       *   (REAL) sample value in [0, 1).
+       */
+      REAL Get1D( INT X, INT Y, INT SampleNo, INT Count, INT Dim ) const
+      {
+        switch (Mode)
+        {
+        case GRID:
+          return (SampleNo + 0.5) / Count;
+        case RANDOM:
+          return ToUnit(Hash(StreamHash(X, Y, Dim) ^ Hash((DWORD)SampleNo)));
+        case STRATIFIED:
+          {
+            DWORD h = StreamHash(X, Y, Dim);
+
+            return (Permute(SampleNo, Count, h) + ToUnit(Hash(h ^ (DWORD)SampleNo))) / Count;
+          }
+        case HALTON:
+          return Frac(RadicalInverse(SampleNo, Primes[Dim % PrimesCount]) +
+                      ToUnit(StreamHash(X, Y, Dim)));
+        case SOBOL:
+          return Sobol(X, Y, SampleNo, Dim);
+        case BLUE_NOISE:
+          return Frac(BlueNoise(X, Y, Dim) + SampleNo * 0.6180339887498949);
+        }
+        return 0;
+      } /* End of 'Get1D' function */
+
+      /* Get 2D sample function.
+       * ARGUMENTS:
+       *   - pixel coordinates:
+       *       INT X, Y;
+       *   - sample number and samples count in pixel:
+       *       INT SampleNo, Count;
+       *   - first dimension (second is Dim + 1):
+       *       INT Dim;
+       * RETURNS:
+       *   (vec2) sample value in [0, 1)^2.
+       */
+      vec2 Get2D( INT X, INT Y, INT SampleNo, INT Count, INT Dim ) const
+      {
+        INT l = (INT)std::sqrt((REAL)Count);
+
+        if (l * l != Count)
+          l = 0;
+        switch (Mode)
+        {
+        case GRID:
+          if (l == 0)
+            break;
+          return vec2((REAL)(SampleNo % l) / l, (REAL)(SampleNo / l) / l);
+        case STRATIFIED:
+          if (l == 0)
+            break;
+          {
+            // Jittered grid cells in random order
+            DWORD h = StreamHash(X, Y, Dim);
+            INT Cell = Permute(SampleNo, Count, h);
+
+            return vec2((Cell % l + ToUnit(Hash(h ^ (DWORD)SampleNo))) / l,
+                        (Cell / l + ToUnit(Hash(h ^ ~(DWORD)SampleNo))) / l);
+          }
+        case BLUE_NOISE:
+          return vec2(Frac(BlueNoise(X, Y, Dim) + SampleNo * 0.7548776662466927),
+                      Frac(BlueNoise(X, Y, Dim + 1) + SampleNo * 0.5698402909980532));
+        default:
+          break;
+        }
+        return vec2(Get1D(X, Y, SampleNo, Count, Dim), Get1D(X, Y, SampleNo, Count, Dim + 1));
+      } /* End of 'Get2D' function */
+
+    private:
+      static const INT PrimesCount = 16;        // Halton bases count
+      static constexpr INT Primes[PrimesCount] =
+      {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53
+      };
+      static const INT MaskSize = 64;           // Blue-noise mask side size (power of 2)
+
+      /* Convert 32-bit value to [0, 1) number function.
+       * ARGUMENTS:
+       *   - value:
+       *       DWORD V;
+       * RETURNS:
+       *   (REAL) number.
+       */
+      static REAL ToUnit( DWORD V )
+      {
+        return V * (1.0 / 4294967296.0);
+      } /* End of 'ToUnit' function */
+
+      /* Get fractional part function.
+       * ARGUMENTS:
+       *   - number:
+       *       REAL V;
+       * RETURNS:
+       *   (REAL) fractional part.
+       */
+      static REAL Frac( REAL V )
+      {
+        return V - std::floor(V);
+      } /* End of 'Frac' function */
+
+      /* Reverse bits order function.
+       * ARGUMENTS:
+       *   - value:
+       *       DWORD V;
+       * RETURNS:
+       *   (DWORD) reversed value.
+       */
+      static DWORD ReverseBits( DWORD V )
+      {
+        V = ((V >> 1) & 0x55555555) | ((V & 0x55555555) << 1);
+        V = ((V >> 2) & 0x33333333) | ((V & 0x33333333) << 2);
+        V = ((V >> 4) & 0x0F0F0F0F) | ((V & 0x0F0F0F0F) << 4);
+        V = ((V >> 8) & 0x00FF00FF) | ((V & 0x00FF00FF) << 8);
+        return (V >> 16) | (V << 16);
+      } /* End of 'ReverseBits' function */
+
+      /* Radical inverse by specified base function.
+       * ARGUMENTS:
+       *   - index:
+       *       INT Index;
+       *   - base:
+       *       INT Base;
+       * RETURNS:
+       *   (REAL) radical inverse value.
+       */
+      static REAL RadicalInverse( INT Index, INT Base )
+      {
+        REAL InvBase = 1.0 / Base, F = InvBase, R = 0;
+
+        for (DWORD i = (DWORD)Index; i > 0; i /= Base, F *= InvBase)
+          R += (i % Base) * F;
+        return R;
+      } /* End of 'RadicalInverse' function */
+
+      /* Random permutation of [0, Count) (A. Kensler, 2013) function.
+       * ARGUMENTS:
+       *   - element number:
+       *       INT I;
+       *   - elements count:
+       *       INT Count;
+       *   - permutation seed:
+       *       DWORD P;
+       * RETURNS:
+       *   (INT) permuted element number.
+       */
+      static INT Permute( INT I, INT Count, DWORD P )
+      {
+        DWORD i = (DWORD)I, l = (DWORD)Count, w = l - 1;
+
+        if (l <= 1)
+          return 0;
+        w |= w >> 1;
+        w |= w >> 2;
+        w |= w >> 4;
+        w |= w >> 8;
+        w |= w >> 16;
+        do
+        {
+          i ^= P; i *= 0xE170893D;
+          i ^= P >> 16;
+          i ^= (i & w) >> 4;
+          i ^= P >> 8; i *= 0x0929EB3F;
+          i ^= P >> 23;
+          i ^= (i & w) >> 1; i *= 1 | P >> 27;
+          i *= 0x6935FA69;
+          i ^= (i & w) >> 11; i *= 0x74DCB303;
+          i ^= (i & w) >> 2; i *= 0x9E501CC3;
+          i ^= (i & w) >> 2; i *= 0xC860A3DF;
+          i &= w;
+          i ^= i >> 5;
+        } while (i >= l);
+        return (INT)((i + P) % l);
+      } /* End of 'Permute' function */
+
+      /* Owen scrambling of 32-bit fixed point value (B. Burley, 2020) function.
+       * ARGUMENTS:
+       *   - value:
+       *       DWORD V;
+       *   - scramble seed:
+       *       DWORD S;
+       * RETURNS:
+       *   (DWORD) scrambled value.
+       */
+      static DWORD OwenScramble( DWORD V, DWORD S )
+      {
+        V = ReverseBits(V);
+        V += S;
+        V ^= V * 0x6C50B47C;
+        V ^= V * 0xB82F1E52;
+        V ^= V * 0xC7AFE638;
+        V ^= V * 0x8D22F6E6;
+        return ReverseBits(V);
+      } /* End of 'OwenScramble' function */
+
+      /* Get Owen-scrambled Sobol sample function.
+       * ARGUMENTS:
+       *   - pixel coordinates:
+       *       INT X, Y;
+       *   - sample number:
+       *       INT SampleNo;
+       *   - dimension:
+       *       INT Dim;
+       * RETURNS:
+       *   (REAL) sample value in [0, 1).
+       */
+      REAL Sobol( INT X, INT Y, INT SampleNo, INT Dim ) const
+      {
+        // Dimensions pairs are first two Sobol dimensions with own index shuffling
+        DWORD Index = OwenScramble((DWORD)SampleNo, StreamHash(X, Y, Dim / 2 * 2)), V = 0;
+
+        if (Dim % 2 == 0)
+          V = ReverseBits(Index);
+        else
+          for (DWORD d = 1u << 31; Index != 0; Index >>= 1, d ^= d >> 1)
+            if (Index & 1)
+              V ^= d;
+        return ToUnit(OwenScramble(V, StreamHash(X, Y, Dim) ^ 0xA511E9B3));
+      } /* End of 'Sobol' function */
+
+      /* Get blue-noise mask value function.
+       * ARGUMENTS:
+       *   - pixel coordinates:
+       *       INT X, Y;
+       *   - dimension:
+       *       INT Dim;
+       * RETURNS:
+       *   (REAL) mask value in [0, 1).
+       */
+      REAL BlueNoise( INT X, INT Y, INT Dim ) const
+      {
+        static const std::vector<FLT> Mask = BuildBlueNoise();
+        DWORD h = Hash(Seed ^ Hash((DWORD)Dim));
+
+        // Other dimensions use toroidally shifted mask
+        return Mask[((Y + (h >> 16)) & (MaskSize - 1)) * MaskSize + ((X + h) & (MaskSize - 1))];
+      } /* End of 'BlueNoise' function */
+
+      /* Build blue-noise mask by void filling (R. Ulichney, 1993) function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (std::vector<FLT>) mask with ranks in [0, 1).
+       */
+      static std::vector<FLT> BuildBlueNoise( VOID )
+      {
+        const INT N = MaskSize * MaskSize;
+        const REAL Sigma = 1.5;
+        std::vector<FLT> Mask(N), Energy(N, 0), Kernel(N);
+        std::vector<BOOL> IsSet(N, FALSE);
+
+        // Toroidal gaussian kernel
+        for (INT y = 0; y < MaskSize; y++)
+          for (INT x = 0; x < MaskSize; x++)
+          {
+            INT
+              dx = x < MaskSize / 2 ? x : MaskSize - x,
+              dy = y < MaskSize / 2 ? y : MaskSize - y;
+
+            Kernel[y * MaskSize + x] = (FLT)std::exp(-(dx * dx + dy * dy) / (2 * Sigma * Sigma));
+          }
+
+        // Each next point is placed to the largest void
+        for (INT r = 0, Best = (INT)(Hash(N) % N); r < N; r++)
+        {
+          INT bx = Best % MaskSize, by = Best / MaskSize;
+
+          IsSet[Best] = TRUE;
+          Mask[Best] = (FLT)((r + 0.5) / N);
+          for (INT y = 0; y < MaskSize; y++)
+            for (INT x = 0; x < MaskSize; x++)
+              Energy[y * MaskSize + x] +=
+                Kernel[((y - by) & (MaskSize - 1)) * MaskSize + ((x - bx) & (MaskSize - 1))];
+
+          Best = -1;
+          for (INT i = 0; i < N; i++)
+            if (!IsSet[i] && (Best == -1 || Energy[i] < Energy[Best]))
+              Best = i;
+        }
+        return Mask;
+      } /* End of 'BuildBlueNoise' function */
+    }; /* End of 'sampler' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__sampler_h_
+
+/* END OF 'sampler.h' FILE */
@@ -5,7 +5,7 @@
 
 /* FILE:        box.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 09.05.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's plane header file.
  * NOTE:        None.
  * 
@@ -30,7 +30,7 @@ namespace pirt
     public:
       vec3
         P1, P2, P[8], N[6]; // point of cube
-      DBL
+      REAL
         D[6]; // d coef of box planes
 
       /* Constructor of box by 2 points
@@ -89,16 +89,16 @@ namespace pirt
        */
       BOOL Intersect( const ray &R, intr *Intr )
       {
-        DBL tnear = -1, tfar = 1000, t0, t1;
+        REAL tnear = -1, tfar = 1000, t0, t1;
         //vec3 res;
 
 #define SET_T(Axis) \
-        if (R.Dir. ## Axis == 0)                                            \
-          if (R.Org. ## Axis < P1. ## Axis && R.Org. ## Axis > P2. ## Axis) \
+        if (R.Dir.Axis == 0)                                            \
+          if (R.Org.Axis < P1.Axis && R.Org.Axis > P2.Axis) \
             return FALSE;                                                   \
                                                                             \
-        t0 = (P1. ## Axis - R.Org. ## Axis) / R.Dir. ## Axis;               \
-        t1 = (P2. ## Axis - R.Org. ## Axis) / R.Dir. ## Axis;               \
+        t0 = (P1.Axis - R.Org.Axis) / R.Dir.Axis;               \
+        t1 = (P2.Axis - R.Org.Axis) / R.Dir.Axis;               \
                                                                             \
         if (t0 > t1)                                                        \
           std::swap(t0, t1);                                                \
@@ -192,11 +192,11 @@ namespace pirt
         {
           P1, P1, P1, P2, P2, P2
         };
-        DBL topt = -1;
+        REAL topt = -1;
 
         for (INT i = 0; i < 6; ++i)
         {
-          DBL T = (N[i] & (P[i] - R.Org)) / (N[i] & R.Dir);
+          REAL T = (N[i] & (P[i] - R.Org)) / (N[i] & R.Dir);
 
           if (T < Treashold)
             continue;
@@ -252,6 +252,20 @@ namespace pirt
         return Intersect(R, &tmp_intr);
       } /* End of 'IsIntersect' function */
 
+
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      BOOL GetBound( vec3 *Min, vec3 *Max ) const override
+      {
+        *Min = vec3((std::min)(P1.X, P2.X), (std::min)(P1.Y, P2.Y), (std::min)(P1.Z, P2.Z));
+        *Max = vec3((std::max)(P1.X, P2.X), (std::max)(P1.Y, P2.Y), (std::max)(P1.Z, P2.Z));
+        return TRUE;
+      } /* End of 'GetBound' function */
     }; /* End of 'box' class */
   } /* end of 'rt' namespace */
 } /* end of 'pirt' namespace */
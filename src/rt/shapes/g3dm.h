@@ -5,7 +5,7 @@
 
 /* FILE:        g3dm.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 09.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's g3dm header file.
  * NOTE:        None.
  * 
@@ -57,7 +57,7 @@ namespace pirt
     struct pr_intr
     {
       const polygon *Pol; // Intersected polygon
-      DBL           T;    // Intersection ray distance
+      REAL          T;    // Intersection ray distance
       vec3          P;    // Position
       vec3          N;    // Normal
     }; /* End of 'pr_intr' function */
@@ -70,10 +70,11 @@ namespace pirt
         P1, P2, P3,    // points of triangle
         N,             // normal of triangle
         U1, V1;        // vectors for search u & v
-      DBL
+      REAL
         u0, v0;        // coef for search u & v
       vec2
         TC1, TC2, TC3; // texture coordinates
+      REAL TexScale;   // Texture coordinates per space unit (for texture footprint)
 
       /* Polygon constructor
        * ARGUMENTS:
@@ -95,6 +96,11 @@ namespace pirt
 
         V1 = (s2 * s1.Len2() - s1 * (s1 & s2)) / (s1.Len2() * s2.Len2() - (s1 & s2) * (s1 & s2));
         v0 = P1 & V1;
+
+        vec2 t1 = tc2 - tc1, t2 = tc3 - tc1;
+        REAL Area = !(s1 % s2);
+
+        TexScale = Area > 0 ? sqrt(fabs(t1.X * t2.Y - t1.Y * t2.X) / Area) : 0;
       } /* End of 'polygon' function */
 
       /* Get intersection function.
@@ -108,19 +114,19 @@ namespace pirt
        */
       BOOL IsIntersect( const ray &R, pr_intr *Intr ) const
       {
-        DBL T = (N & (P1 - R.Org)) / (N & R.Dir);
+        REAL T = (N & (P1 - R.Org)) / (N & R.Dir);
 
         if (T < Treashold)
           return FALSE;
 
         Intr->P = R.Org + R.Dir * T;
 
-        DBL u = (Intr->P & U1) - u0;
+        REAL u = (Intr->P & U1) - u0;
 
         if (u < Treashold)
           return FALSE;
 
-        DBL v = (Intr->P & V1) - v0;
+        REAL v = (Intr->P & V1) - v0;
 
         if (v < Treashold)
           return FALSE;
@@ -155,9 +161,9 @@ namespace pirt
        */
       vec2 GetTC( const vec3 &P ) const
       {
-        DBL u = (P & U1) - u0;
-        DBL v = (P & V1) - v0;
-        DBL w = 1 - u - v;
+        REAL u = (P & U1) - u0;
+        REAL v = (P & V1) - v0;
+        REAL w = 1 - u - v;
 
         //assert(u < 1 && v < 1 && u > 0 && v > 0 && u + v < 1);
 
@@ -232,7 +238,7 @@ namespace pirt
         for (INT i = 0; i < 6; ++i)
         {
           // Find the intersection with the planes of sides
-          DBL T = (N[i] & (P[i] - R.Org)) / (N[i] & R.Dir);
+          REAL T = (N[i] & (P[i] - R.Org)) / (N[i] & R.Dir);
 
           if (T < Treashold)
             continue;
@@ -337,7 +343,7 @@ namespace pirt
       BOOL Intersect( const ray &R, pr_intr *Intr )
       {
         pr_intr tmp;
-        DBL BestT = -1;
+        REAL BestT = -1;
 
         if (Less != nullptr && Less->BBIsIntersected(R, MinBB, MaxBB))
           if (Less->Intersect(R, &tmp) && (BestT > tmp.T || BestT == -1))
@@ -365,7 +371,7 @@ namespace pirt
       INT AllIntersect( const ray &R, std::vector<pr_intr> &Il )
       {
         pr_intr tmp;
-        DBL BestT = -1;
+        REAL BestT = -1;
         INT count {};
 
         if (Less != nullptr && Less->BBIsIntersected(R, MinBB, MaxBB))
@@ -629,7 +635,9 @@ namespace pirt
           //{
             //printf("%lf%lf%lf %lf%lf%lf\n", In->V[0].X, In->V[0].Y, In->V[0].Z, In->P.X, In->P.Y, In->P.Z);
           //}
-          return TexManager.GetTexByNo(Surf.TexNum[0])->GetColor(reinterpret_cast<const polygon *>(In->Ptr[0])->GetTC(In->V[0]));
+          const polygon *Pol = reinterpret_cast<const polygon *>(In->Ptr[0]);
+
+          return TexManager.GetTexByNo(Surf.TexNum[0])->GetColor(Pol->GetTC(In->V[0]), In->Footprint * Pol->TexScale);
         }
         return Surf.Kd;
       } /* End of 'Mode' function */
@@ -771,7 +779,10 @@ namespace pirt
           ptr += 4;
           C = *(DWORD *)ptr;
           ptr += 4;
-          TexManager.AddTexture(W, H, C, (const VOID *)ptr);
+          if (TexManager.IsLazy)
+            TexManager.AddLazyTexture(filename, ptr - mem, W, H, C);
+          else
+            TexManager.AddTexture(W, H, C, (const VOID *)ptr);
 
 #if 0
           FILE *F = fopen(std::format("{}.g32", t).c_str(), "wb");
@@ -811,7 +822,7 @@ namespace pirt
        */
       BOOL Intersect( const ray &R, intr *Intr )
       {
-        DBL t = -1;
+        REAL t = -1;
         intr tmp;
 
         for (auto &i : Prims)
@@ -900,6 +911,27 @@ namespace pirt
         return FALSE;
       } /* End of 'IsIntersect' function */
 
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      BOOL GetBound( vec3 *Min, vec3 *Max ) const override
+      {
+        BOOL IsFirst = TRUE;
+
+        for (auto &Pr : Prims)
+          if (IsFirst)
+            *Min = Pr.MinBB, *Max = Pr.MaxBB, IsFirst = FALSE;
+          else
+          {
+            *Min = vec3((std::min)(Min->X, Pr.MinBB.X), (std::min)(Min->Y, Pr.MinBB.Y), (std::min)(Min->Z, Pr.MinBB.Z));
+            *Max = vec3((std::max)(Max->X, Pr.MaxBB.X), (std::max)(Max->Y, Pr.MaxBB.Y), (std::max)(Max->Z, Pr.MaxBB.Z));
+          }
+        return !IsFirst;
+      } /* End of 'GetBound' function */
     }; /* End of 'g3dm' function */
 
   } /* end of 'rt' namespace */
@@ -5,7 +5,7 @@
 
 /* FILE:        objmodel.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 26.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's obj model header file.
  * NOTE:        None.
  * 
@@ -129,7 +129,7 @@ namespace pirt
       ~objmodel( VOID ) override
       {
         for (INT i = 0; i < CountOfTriangles; ++i)
-          delete[] TrArray[i];
+          delete TrArray[i];
 
         delete[] TrArray;
       } /* End of '~box' function' */
@@ -258,6 +258,33 @@ namespace pirt
 
         return FALSE;
       } /* End of 'IsIntersect' function */
+
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      BOOL GetBound( vec3 *Min, vec3 *Max ) const override
+      {
+        BOOL IsFirst = TRUE;
+
+        for (INT i = 0; i < CountOfTriangles; ++i)
+        {
+          vec3 TMin, TMax;
+
+          TrArray[i]->GetBound(&TMin, &TMax);
+          if (IsFirst)
+            *Min = TMin, *Max = TMax, IsFirst = FALSE;
+          else
+          {
+            *Min = vec3((std::min)(Min->X, TMin.X), (std::min)(Min->Y, TMin.Y), (std::min)(Min->Z, TMin.Z));
+            *Max = vec3((std::max)(Max->X, TMax.X), (std::max)(Max->Y, TMax.Y), (std::max)(Max->Z, TMax.Z));
+          }
+        }
+        return !IsFirst;
+      } /* End of 'GetBound' function */
     }; /* End of 'triangle' class */
   } /* end of 'rt' namespace */
 } /* end of 'pirt' namespace */
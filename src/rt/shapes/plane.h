@@ -5,7 +5,7 @@
 
 /* FILE:        plane.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 05.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's plane header file.
  * NOTE:        None.
  * 
@@ -16,8 +16,6 @@
 #ifndef __plane_h_
 #define __plane_h_
 
-#include <conio.h>
-
 #include "../rt_def.h"
 #include "../tex/texture.h"
 
@@ -97,8 +95,8 @@ namespace pirt
        */
       BOOL Intersect( const ray &R, intr *Intr ) override
       {
-        //DBL T = -(N.operator&(P) + 1.0) / (N & R.Dir);
-        DBL T = (N & (P - R.Org)) / (N & R.Dir);
+        //REAL T = -(N.operator&(P) + 1.0) / (N & R.Dir);
+        REAL T = (N & (P - R.Org)) / (N & R.Dir);
 
         if (T < Treashold)// || T > 1000)
           return FALSE;
@@ -191,7 +189,8 @@ namespace pirt
           if (tc.Y < 0)
             tc.Y = 1 + tc.Y;
 
-          return Tex->GetColor(tc);
+          // Texture is repeated every 5 units
+          return Tex->GetColor(tc, In->Footprint / 5);
         }
         else
         {
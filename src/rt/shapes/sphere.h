@@ -5,7 +5,7 @@
 
 /* FILE:        sphere.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 24.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's sphere header file.
  * NOTE:        None.
  * 
@@ -29,7 +29,7 @@ namespace pirt
     public:
       vec3
         Center; // Center of sphere
-      DBL
+      REAL
         R2;     // radius^2 of sphere
 
       /* Sphere constructor.
@@ -39,9 +39,9 @@ namespace pirt
        *   - material name:
        *       const CHAR *MtlName;
        *   - radius:
-       *       DBL Radius;
+       *       REAL Radius;
        */
-      sphere( vec3 Cen, DBL Radius, const CHAR *MtlName = "Gold" ) : Center(Cen), R2(Radius * Radius), shape(surface(MtlName))
+      sphere( vec3 Cen, REAL Radius, const CHAR *MtlName = "Gold" ) : Center(Cen), R2(Radius * Radius), shape(surface(MtlName))
       {
         this->material = 2;
       } /* End of 'sphere' function */
@@ -63,7 +63,7 @@ namespace pirt
       BOOL Intersect( const ray &R, intr *Intr ) override
       {
         vec3 a = Center - R.Org;
-        DBL 
+        REAL 
           oc2 = a.Len2(),
           ok = a & R.Dir,
           ok2 = ok * ok,
@@ -111,14 +111,14 @@ namespace pirt
       INT AllIntersect( const ray &R, intr_list &Il ) override
       {
         vec3 a = Center - R.Org;
-        DBL 
+        REAL 
           oc2 = a.Len2(),
           ok = a & R.Dir,
           ok2 = ok * ok,
           h2 = R2 - (oc2 - ok2);
         INT count = 0;
 
-        DBL tmp = ok + std::sqrt(h2);
+        REAL tmp = ok + std::sqrt(h2);
 
         if (tmp > Treashold)
         {
@@ -187,7 +187,7 @@ namespace pirt
        */
       BOOL IsInside( const vec3 &P ) override
       {
-        DBL 
+        REAL 
           x = P.X - Center.X,
           y = P.Y - Center.Y,
           z = P.Z - Center.Z;
@@ -205,7 +205,7 @@ namespace pirt
       BOOL IsIntersect( const ray &R ) override
       {
         vec3 a = Center - R.Org;
-        DBL 
+        REAL 
           oc2 = a.Len2(),
           ok = a & R.Dir,
           ok2 = ok * ok,
@@ -219,6 +219,22 @@ namespace pirt
           return FALSE;
         return TRUE;
       } /* End of 'IsIntersect' function */
+
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      BOOL GetBound( vec3 *Min, vec3 *Max ) const override
+      {
+        REAL R = sqrt(R2);
+
+        *Min = Center - vec3(R);
+        *Max = Center + vec3(R);
+        return TRUE;
+      } /* End of 'GetBound' function */
     }; /* End of 'sphere' class */
   } /* end of 'rt' namespace */
 } /* end of 'pirt' namespace */
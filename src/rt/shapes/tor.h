@@ -5,7 +5,7 @@
 
 /* FILE:        tor.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 01.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's tor header file.
  * NOTE:        None.
  * 
@@ -135,6 +135,7 @@ namespace pirt
        */
       BOOL Intersect( const ray &R, intr *Intr )
       {
+        // Quartic coefficients cancel a lot, solver works in double for any renderer precision
         DBL po = 1.0;
         vec3 L = R.Org - pos;
         DBL 
@@ -146,7 +147,7 @@ namespace pirt
           k1 = n * k - R2 * (vec2(R.Dir.X, R.Dir.Y) & vec2(L.X, L.Y)),
           k0 = k * k - R2 * (vec2(L.X, L.Y) & vec2(L.X, L.Y));
       
-        if (abs(k3 * (k3 * k3 - k2) + k1) < Treashold)
+        if (std::abs(k3 * (k3 * k3 - k2) + k1) < Treashold)
         {
           po = -1.0;
           std::swap(k1, k3);
@@ -172,9 +173,9 @@ namespace pirt
         {
           h = sqrt(h);
           DBL 
-            v = COM_SIGN(Rk + h) * pow(abs(Rk + h), 1.0 / 3.0),
-            u = COM_SIGN(Rk - h) * pow(abs(Rk - h), 1.0 / 3.0); 
-          vec2 s {(v + u) + 4.0 * c2, (v - u) * sqrt(3.0)};
+            v = COM_SIGN(Rk + h) * pow(std::abs(Rk + h), 1.0 / 3.0),
+            u = COM_SIGN(Rk - h) * pow(std::abs(Rk - h), 1.0 / 3.0); 
+          mth::vec2<DBL> s {(v + u) + 4.0 * c2, (v - u) * sqrt(3.0)};
           DBL 
             y = sqrt(0.5 * ((!s) + s.X)),
             x = 0.5 * s.Y / y,
@@ -190,7 +191,7 @@ namespace pirt
           if (t1 > 0.0) 
             t = t1, flag = TRUE;
           if (t2 > 0.0) 
-            t = min(t, t2), flag = TRUE;
+            t = (std::min)(t, t2), flag = TRUE;
 
           if (!flag)
             return FALSE;
@@ -228,11 +229,11 @@ namespace pirt
         if (t1 > 0.0) 
           t = t1, flag = TRUE;
         if (t2 > 0.0) 
-          t = min(t, t2), flag = TRUE;
+          t = (std::min)(t, t2), flag = TRUE;
         if (t3 > 0.0)
-          t = min(t, t3), flag = TRUE;
+          t = (std::min)(t, t3), flag = TRUE;
         if (t4 > 0.0) 
-          t = min(t, t4), flag = TRUE;
+          t = (std::min)(t, t4), flag = TRUE;
 
         if (!flag)
           return FALSE;
@@ -295,6 +296,23 @@ namespace pirt
         return Intersect(R, &tmp_intr);
       } /* End of 'IsIntersect' function */
 
+
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      BOOL GetBound( vec3 *Min, vec3 *Max ) const override
+      {
+        // Tor lies in XY plane
+        DBL r = sqrt(r2), R = sqrt(R2) + r;
+
+        *Min = pos - vec3(R, R, r);
+        *Max = pos + vec3(R, R, r);
+        return TRUE;
+      } /* End of 'GetBound' function */
     }; /* End of 'tor' class */
   } /* end of 'rt' namespace */
 } /* end of 'pirt' namespace */
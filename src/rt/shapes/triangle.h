@@ -5,7 +5,7 @@
 
 /* FILE:        triangle.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 26.07.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's triangle header file.
  * NOTE:        None.
  * 
@@ -32,7 +32,7 @@ namespace pirt
         P1, P2, P3, // points of triangle;
         N,          // normal of triangle
         U1, V1;     // vectors for search u & v
-      DBL
+      REAL
         u0, v0;     // coef for search u & v
 
       /* Constructor of triangle by 3 points
@@ -71,19 +71,19 @@ namespace pirt
        */
       BOOL Intersect( const ray &R, intr *Intr )
       {
-        DBL T = (N & (P1 - R.Org)) / (N & R.Dir);
+        REAL T = (N & (P1 - R.Org)) / (N & R.Dir);
 
         if (T < Treashold)
           return FALSE;
 
         Intr->P = R.Org + R.Dir * T;
 
-        DBL u = (Intr->P & U1) - u0;
+        REAL u = (Intr->P & U1) - u0;
 
         if (u < Treashold)
           return FALSE;
 
-        DBL v = (Intr->P & V1) - v0;
+        REAL v = (Intr->P & V1) - v0;
 
         if (v < Treashold)
           return FALSE;
@@ -156,6 +156,20 @@ namespace pirt
         return Intersect(R, &tmp_intr);
       } /* End of 'IsIntersect' function */
 
+
+      /* Get bound box (in shape coordinates, before matrix) function.
+       * ARGUMENTS:
+       *   - bound box to be set:
+       *       vec3 *Min, *Max;
+       * RETURNS:
+       *   (BOOL) TRUE if shape is bounded, FALSE otherwise.
+       */
+      BOOL GetBound( vec3 *Min, vec3 *Max ) const override
+      {
+        *Min = vec3((std::min)({P1.X, P2.X, P3.X}), (std::min)({P1.Y, P2.Y, P3.Y}), (std::min)({P1.Z, P2.Z, P3.Z}));
+        *Max = vec3((std::max)({P1.X, P2.X, P3.X}), (std::max)({P1.Y, P2.Y, P3.Y}), (std::max)({P1.Z, P2.Z, P3.Z}));
+        return TRUE;
+      } /* End of 'GetBound' function */
     }; /* End of 'triangle' class */
   } /* end of 'rt' namespace */
 } /* end of 'pirt' namespace */
@@ -5,9 +5,25 @@
 
 /* FILE:        texture.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 05.09.2024
+ * LAST UPDATE: 18.10.2026
  * PURPOSE:     RayTracing's texture and texture manager header file.
- * NOTE:        None.
+ * NOTE:        Mip pyramid is built on texture creation, filtered
+ *              lookups select level by footprint width. Levels are
+ *              stored row by row or by 4x4 texels tiles (one 64 bytes
+ *              cache line per tile, rows of tiles are padded) or
+ *              compressed by 4x4 tiles into 8 bytes blocks (BC1-like:
+ *              two RGB 5:6:5 end points and 2 bits palette index per
+ *              texel, alpha is dropped), decoded at lookup time, or
+ *              converted once to float colors (16 bytes per texel).
+ *              Texel bytes are converted to colors by table (identity
+ *              or sRGB to linear light), so float and byte storages
+ *              give the same colors.
+ *              Lazy textures keep only texels position in source file,
+ *              they are decoded on first lookup into textures cache
+ *              (shared by threads, limited by memory budget, least
+ *              recently used textures are evicted). Every thread keeps
+ *              few last used lazy textures, so cache is locked only
+ *              when thread switches textures.
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -16,6 +32,17 @@
 #ifndef __texture_h_
 #define __texture_h_
 
+#include <vector>
+#include <list>
+#include <map>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
 #include "../rt_def.h"
 
 /* Base project namespace */
@@ -27,39 +54,359 @@ namespace pirt
     /* Texture class */
     class texture
     {
-    private:
-      DWORD *Buf; // Buffer of texture
-      INT
-        W, H;     // Size of image
-
     public:
-      INT Num;    // Texture number in stock
+      /* Texture filtering modes */
+      enum FILTER
+      {
+        NEAREST,   // Nearest texel of full resolution image (clamped coordinates)
+        BILINEAR,  // Bilinear filtering of nearest by footprint mip level
+        TRILINEAR  // Bilinear filtering of two nearest by footprint mip levels
+      };
+      static inline FILTER Filter = TRILINEAR; // Filtering mode of all textures
 
-      /* Default constructor */
-      texture() : W(0), H(0), Buf(nullptr), Num(-1)
+      /* Texels memory layouts */
+      enum LAYOUT
       {
-      } /* End of 'texture' function */
+        LINEAR,    // Row by row
+        TILED      // 4x4 texels tiles, tiles row by row
+      };
+      static inline LAYOUT DefaultLayout = TILED; // Layout of created textures
 
-      /* Constructor function.
-       * ARGUMENTS:
-       *   - other texture:
-       *       texture &&Other;
-       */
-      texture( texture &&Other ) : W(Other.W), H(Other.H), Num(Other.Num)
+      /* Texels storage formats */
+      enum FORMAT
       {
-        std::swap(Other.Buf, Buf);
-        Other.Buf = nullptr;
-      } /* End of 'texture' function */
+        BGRA8,     // 4 bytes per texel
+        BC1,       // 8 bytes per 4x4 texels block
+        RGB32F     // 16 bytes per texel (converted colors, padded to 4 floats)
+      };
+      static inline FORMAT DefaultFormat = BGRA8; // Storage format of created textures
+
+      /* Texel byte to color channel conversion table class */
+      class channel_table
+      {
+      public:
+        REAL V[256];                // Channel values
+
+        /* Build table constructor.
+         * ARGUMENTS:
+         *   - sRGB to linear light conversion flag:
+         *       BOOL IsSRGB;
+         */
+        channel_table( BOOL IsSRGB )
+        {
+          for (INT i = 0; i < 256; i++)
+          {
+            REAL c = i / 255.;
+
+            V[i] = !IsSRGB ? c : c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+          }
+        } /* End of 'channel_table' function */
+      }; /* End of 'channel_table' class */
+      static inline const channel_table
+        LinearTable {FALSE},        // Identity conversion table
+        SRGBTable {TRUE};           // sRGB to linear light conversion table
+      static inline const REAL *Channel = LinearTable.V; // Current conversion table (set before textures creation)
 
-      /* Constructor function.
+      /* Set texels color space function.
        * ARGUMENTS:
-       *   - other texture:
-       *       const texture &Other;
+       *   - texels are sRGB encoded flag:
+       *       BOOL IsSRGB;
+       * RETURNS: None.
        */
-      texture( const texture &Other ) : W(Other.W), H(Other.H), Num(Other.Num)
+      static VOID SetSRGB( BOOL IsSRGB )
+      {
+        Channel = IsSRGB ? SRGBTable.V : LinearTable.V;
+      } /* End of 'SetSRGB' function */
+
+      /* Mip level class */
+      class level
+      {
+      public:
+        INT W, H;                 // Level size
+        std::vector<DWORD> Texels; // Level texels (B, G, R, A bytes)
+        INT TilesW = 0;           // Tiles in row count (0 for linear layout)
+        std::vector<UINT64> Blocks; // Compressed tiles (empty if not compressed)
+        std::vector<fvec4> Colors;  // Float colors (empty if not converted, same layout as texels)
+
+        /* Get texel index part by column function.
+         * ARGUMENTS:
+         *   - texel column:
+         *       INT X;
+         * RETURNS:
+         *   (UINT_PTR) index part (index is sum of column and row parts).
+         */
+        UINT_PTR OffsetX( INT X ) const
+        {
+          return TilesW == 0 ? X : ((UINT_PTR)(X >> 2) << 4) + (X & 3);
+        } /* End of 'OffsetX' function */
+
+        /* Get texel index part by row function.
+         * ARGUMENTS:
+         *   - texel row:
+         *       INT Y;
+         * RETURNS:
+         *   (UINT_PTR) index part (index is sum of column and row parts).
+         */
+        UINT_PTR OffsetY( INT Y ) const
+        {
+          return TilesW == 0 ? (UINT_PTR)Y * W : (((UINT_PTR)(Y >> 2) * TilesW) << 4) + ((Y & 3) << 2);
+        } /* End of 'OffsetY' function */
+
+        /* Get texel function.
+         * ARGUMENTS:
+         *   - texel coordinates (in level):
+         *       INT X, Y;
+         * RETURNS:
+         *   (DWORD) texel.
+         */
+        DWORD Texel( INT X, INT Y ) const
+        {
+          if (!Blocks.empty())
+            return Decode(Blocks[(UINT_PTR)(Y >> 2) * TilesW + (X >> 2)], ((Y & 3) << 2) + (X & 3));
+          return Texels[OffsetX(X) + OffsetY(Y)];
+        } /* End of 'Texel' function */
+
+        /* Get texel color function.
+         * ARGUMENTS:
+         *   - texel coordinates (in level):
+         *       INT X, Y;
+         * RETURNS:
+         *   (vec3) color.
+         */
+        vec3 Color( INT X, INT Y ) const
+        {
+          if (!Colors.empty())
+          {
+            const fvec4 &C = Colors[OffsetX(X) + OffsetY(Y)];
+
+            return vec3(C.X, C.Y, C.Z);
+          }
+          return ToColor(Texel(X, Y));
+        } /* End of 'Color' function */
+
+        /* Convert 5:6:5 color to texel function.
+         * ARGUMENTS:
+         *   - 5:6:5 color:
+         *       DWORD C;
+         * RETURNS:
+         *   (DWORD) texel (zero alpha).
+         */
+        static DWORD From565( DWORD C )
+        {
+          DWORD
+            r = (C >> 11) & 0x1F, g = (C >> 5) & 0x3F, b = C & 0x1F;
+
+          return COM_MAKELONG0123((b << 3) | (b >> 2), (g << 2) | (g >> 4), (r << 3) | (r >> 2), 0);
+        } /* End of 'From565' function */
+
+        /* Mix two texels function.
+         * ARGUMENTS:
+         *   - texels:
+         *       DWORD A, B;
+         *   - weights (in thirds):
+         *       DWORD Wa, Wb;
+         * RETURNS:
+         *   (DWORD) mixed texel.
+         */
+        static DWORD Mix( DWORD A, DWORD B, DWORD Wa, DWORD Wb )
+        {
+          DWORD r = 0;
+
+          for (INT s = 0; s < 24; s += 8)
+            r |= ((((A >> s) & 0xFF) * Wa + ((B >> s) & 0xFF) * Wb) / 3) << s;
+          return r;
+        } /* End of 'Mix' function */
+
+        /* Decode compressed block texel function.
+         * ARGUMENTS:
+         *   - block:
+         *       UINT64 B;
+         *   - texel number in block (row by row):
+         *       INT No;
+         * RETURNS:
+         *   (DWORD) texel.
+         */
+        static DWORD Decode( UINT64 B, INT No )
+        {
+          DWORD
+            c0 = From565((DWORD)B & 0xFFFF),
+            c1 = From565((DWORD)(B >> 16) & 0xFFFF);
+
+          switch ((B >> (32 + 2 * No)) & 3)
+          {
+          case 0:
+            return c0;
+          case 1:
+            return c1;
+          case 2:
+            return Mix(c0, c1, 2, 1);
+          default:
+            return Mix(c0, c1, 1, 2);
+          }
+        } /* End of 'Decode' function */
+
+        /* Convert texels to float colors function.
+         * ARGUMENTS: None.
+         * RETURNS: None.
+         */
+        VOID ToFloat( VOID )
+        {
+          if (Texels.empty())
+            return;
+          Colors.resize(Texels.size());
+          for (UINT_PTR i = 0; i < Texels.size(); i++)
+          {
+            DWORD t = Texels[i];
+
+            Colors[i] = fvec4((FLT)Channel[(t >> 16) & 0xFF], (FLT)Channel[(t >> 8) & 0xFF], (FLT)Channel[t & 0xFF], 0);
+          }
+          Texels.clear();
+          Texels.shrink_to_fit();
+        } /* End of 'ToFloat' function */
+
+        /* Compress level function.
+         * ARGUMENTS: None.
+         * RETURNS: None.
+         */
+        VOID Compress( VOID )
+        {
+          if (Texels.empty())
+            return;
+          INT TilesH = (H + 3) / 4;
+
+          std::vector<UINT64> New((UINT_PTR)((W + 3) / 4) * TilesH);
+
+          for (INT ty = 0; ty < TilesH; ty++)
+            for (INT tx = 0; tx < (W + 3) / 4; tx++)
+            {
+              vec3 C[16], Avg;
+
+              // Out of level texels repeat edge ones
+              for (INT i = 0; i < 16; i++)
+              {
+                DWORD t =
+                  Texel((std::min)(tx * 4 + (i & 3), W - 1), (std::min)(ty * 4 + (i >> 2), H - 1));
+
+                C[i] = vec3(t & 0xFF, (t >> 8) & 0xFF, (t >> 16) & 0xFF);
+                Avg += C[i] / 16;
+              }
+
+              // Principal axis of block colors (by power iterations on covariance)
+              REAL Cov[6] {};
+
+              for (INT i = 0; i < 16; i++)
+              {
+                vec3 D = C[i] - Avg;
+
+                Cov[0] += D.X * D.X, Cov[1] += D.X * D.Y, Cov[2] += D.X * D.Z;
+                Cov[3] += D.Y * D.Y, Cov[4] += D.Y * D.Z, Cov[5] += D.Z * D.Z;
+              }
+              vec3 Axis(1, 1, 1);
+
+              for (INT k = 0; k < 4; k++)
+              {
+                Axis = vec3(Cov[0] * Axis.X + Cov[1] * Axis.Y + Cov[2] * Axis.Z,
+                            Cov[1] * Axis.X + Cov[3] * Axis.Y + Cov[4] * Axis.Z,
+                            Cov[2] * Axis.X + Cov[4] * Axis.Y + Cov[5] * Axis.Z);
+                REAL l = !Axis;
+
+                if (l < Threshold)
+                {
+                  Axis = vec3(1, 1, 1);
+                  break;
+                }
+                Axis /= l;
+              }
+
+              // End points are extreme block colors along axis
+              INT i0 = 0, i1 = 0;
+
+              for (INT i = 1; i < 16; i++)
+              {
+                if ((C[i] & Axis) < (C[i0] & Axis))
+                  i0 = i;
+                if ((C[i] & Axis) > (C[i1] & Axis))
+                  i1 = i;
+              }
+              auto To565 =
+                []( const vec3 &V ) -> DWORD
+                {
+                  return ((DWORD)(V.Z * 31 / 255 + 0.5) << 11) | ((DWORD)(V.Y * 63 / 255 + 0.5) << 5) |
+                          (DWORD)(V.X * 31 / 255 + 0.5);
+                };
+              DWORD e0 = To565(C[i0]), e1 = To565(C[i1]), Pal[4];
+
+              Pal[0] = From565(e0);
+              Pal[1] = From565(e1);
+              Pal[2] = Mix(Pal[0], Pal[1], 2, 1);
+              Pal[3] = Mix(Pal[0], Pal[1], 1, 2);
+
+              UINT64 B = e0 | ((UINT64)e1 << 16);
+
+              for (INT i = 0; i < 16; i++)
+              {
+                INT Best = 0;
+                REAL BestD = -1;
+
+                for (INT p = 0; p < 4; p++)
+                {
+                  vec3 D = C[i] - vec3(Pal[p] & 0xFF, (Pal[p] >> 8) & 0xFF, (Pal[p] >> 16) & 0xFF);
+
+                  if (BestD < 0 || (D & D) < BestD)
+                    BestD = D & D, Best = p;
+                }
+                B |= (UINT64)Best << (32 + 2 * i);
+              }
+              New[(UINT_PTR)ty * ((W + 3) / 4) + tx] = B;
+            }
+          Blocks = std::move(New);
+          TilesW = (W + 3) / 4;
+          Texels.clear();
+          Texels.shrink_to_fit();
+        } /* End of 'Compress' function */
+
+        /* Change texels layout function.
+         * ARGUMENTS:
+         *   - new layout:
+         *       LAYOUT L;
+         * RETURNS: None.
+         */
+        VOID SetLayout( LAYOUT L )
+        {
+          INT NewTilesW = L == TILED ? (W + 3) / 4 : 0;
+
+          // Compressed blocks are always stored by tiles, float colors are not relaid
+          if (NewTilesW == TilesW || !Blocks.empty() || !Colors.empty())
+            return;
+          std::vector<DWORD> New(L == TILED ? (UINT_PTR)NewTilesW * ((H + 3) / 4) * 16 : (UINT_PTR)W * H);
+
+          for (INT y = 0; y < H; y++)
+            for (INT x = 0; x < W; x++)
+              New[L == TILED ? (((UINT_PTR)(y >> 2) * NewTilesW) << 4) + ((y & 3) << 2) + ((UINT_PTR)(x >> 2) << 4) + (x & 3) :
+                               (UINT_PTR)y * W + x] = Texel(x, y);
+          Texels = std::move(New);
+          TilesW = NewTilesW;
+        } /* End of 'SetLayout' function */
+      }; /* End of 'level' class */
+
+    private:
+      friend class texture_cache;
+
+      std::vector<level> Levels; // Mip pyramid (level 0 - full resolution image, empty for lazy texture)
+      INT
+        W, H;     // Size of image
+      std::string FileName;      // Lazy texture source file name (empty if texture keeps texels)
+      UINT_PTR Offset = 0;       // Lazy texture texels offset in file
+      INT Channels = 0;          // Lazy texture bytes per texel
+      UINT64 Id = 0;             // Lazy texture unique identifier
+      static inline std::atomic<UINT64> NextId = 1; // Next lazy texture identifier
+
+    public:
+      INT Num;    // Texture number in stock
+
+      /* Default constructor */
+      texture() : W(0), H(0), Num(-1)
       {
-        Buf = new DWORD[W * H];
-        memcpy(Buf, Other.Buf, W * H * 4);
       } /* End of 'texture' function */
 
       /* Constructor by base parameters
@@ -73,9 +420,11 @@ namespace pirt
        *   - number:
        *       INT TNum;
        */
-      texture( INT NewW, INT NewH, INT C, const VOID *NewBuf, INT TNum ) : W(NewW), H(NewH), Buf(new DWORD[NewW * NewH]), Num(TNum)
+      texture( INT NewW, INT NewH, INT C, const VOID *NewBuf, INT TNum ) : W(NewW), H(NewH), Num(TNum)
       {
-        DWORD *ptr = Buf;
+        Levels.push_back({NewW, NewH, std::vector<DWORD>((UINT_PTR)NewW * NewH)});
+
+        DWORD *ptr = Levels[0].Texels.data();
         const BYTE *src = reinterpret_cast<const BYTE *>(NewBuf);
 
         switch (C)
@@ -103,7 +452,7 @@ namespace pirt
 
         // Four bytes texture: texture with alpha
         case 4:
-          std::memcpy(Buf, NewBuf, (UINT_PTR)NewW * NewH * 4);
+          std::memcpy(ptr, NewBuf, (UINT_PTR)NewW * NewH * 4);
           break;
 
         // Invalide count of bytes for texture
@@ -111,19 +460,187 @@ namespace pirt
           assert(0 && "Invalide texture!");
           break;
         }
+        BuildMips();
+        SetLayout(DefaultLayout);
+        if (DefaultFormat == BC1)
+          Compress();
+        else if (DefaultFormat == RGB32F)
+          ToFloat();
       } /* End of 'texture' function */
 
-      /* Delete texture function.
+      /* Lazy texture constructor.
+       * ARGUMENTS:
+       *   - source file name and texels offset in it:
+       *       const std::string &NewFileName;
+       *       UINT_PTR NewOffset;
+       *   - size:
+       *       INT NewW, INT NewH;
+       *   - count of bytes to one pixel:
+       *       INT C;
+       *   - number:
+       *       INT TNum;
+       */
+      texture( const std::string &NewFileName, UINT_PTR NewOffset, INT NewW, INT NewH, INT C, INT TNum ) :
+        W(NewW), H(NewH), FileName(NewFileName), Offset(NewOffset), Channels(C), Id(NextId++), Num(TNum)
+      {
+      } /* End of 'texture' function */
+
+      /* Textures are moved only (texels may be large) */
+      texture( texture && ) = default;
+      texture & operator=( texture && ) = default;
+      texture( const texture & ) = delete;
+      texture & operator=( const texture & ) = delete;
+
+      /* Get texture width function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) level 0 width.
+       */
+      INT GetW( VOID ) const
+      {
+        return W;
+      } /* End of 'GetW' function */
+
+      /* Get texture height function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) level 0 height.
+       */
+      INT GetH( VOID ) const
+      {
+        return H;
+      } /* End of 'GetH' function */
+
+      /* Get mip pyramid memory size function.
+       * ARGUMENTS:
+       *   - levels:
+       *       const std::vector<level> &Lv;
+       * RETURNS:
+       *   (UINT_PTR) size in bytes.
+       */
+      static UINT_PTR MemorySize( const std::vector<level> &Lv )
+      {
+        UINT_PTR Size = 0;
+
+        for (auto &L : Lv)
+          Size += L.Texels.size() * sizeof(DWORD) + L.Blocks.size() * sizeof(UINT64) + L.Colors.size() * sizeof(fvec4);
+        return Size;
+      } /* End of 'MemorySize' function */
+
+      /* Get texels memory size function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (UINT_PTR) size in bytes (lazy textures are counted by cache).
+       */
+      UINT_PTR MemorySize( VOID ) const
+      {
+        return MemorySize(Levels);
+      } /* End of 'MemorySize' function */
+
+      /* Check lazy texture function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if texels are decoded on demand, FALSE otherwise.
+       */
+      BOOL IsLazy( VOID ) const
+      {
+        return !FileName.empty();
+      } /* End of 'IsLazy' function */
+
+      /* Decode (or decode again by current layout and format) lazy texture texels to be kept by texture function.
        * ARGUMENTS: None.
        * RETURNS: None.
        */
-      VOID Free()
+      VOID Load( VOID )
+      {
+        if (IsLazy())
+          Levels = Decode();
+      } /* End of 'Load' function */
+
+      /* Check compressed storage function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if texture is compressed, FALSE otherwise.
+       */
+      BOOL IsCompressed( VOID ) const
       {
-        if (Buf != nullptr)
+        return !Levels.empty() && !Levels[0].Blocks.empty();
+      } /* End of 'IsCompressed' function */
+
+      /* Convert all levels to float colors function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID ToFloat( VOID )
+      {
+        for (auto &Lv : Levels)
+          Lv.ToFloat();
+      } /* End of 'ToFloat' function */
+
+      /* Compress all levels (by 4x4 texels blocks) function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Compress( VOID )
+      {
+        for (auto &Lv : Levels)
+          Lv.Compress();
+      } /* End of 'Compress' function */
+
+      /* Change texels layout of all levels function.
+       * ARGUMENTS:
+       *   - new layout:
+       *       LAYOUT L;
+       * RETURNS: None.
+       */
+      VOID SetLayout( LAYOUT L )
+      {
+        for (auto &Lv : Levels)
+          Lv.SetLayout(L);
+      } /* End of 'SetLayout' function */
+
+      /* Build mip pyramid (2x2 box filter) from level 0 function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID BuildMips( VOID )
+      {
+        Levels.resize(1);
+        Levels[0].SetLayout(LINEAR);
+        while (Levels.back().W > 1 || Levels.back().H > 1)
         {
-          delete[] Buf;
-          Buf = nullptr;
+          const level &Src = Levels.back();
+          level Dst {(std::max)(Src.W / 2, 1), (std::max)(Src.H / 2, 1)};
+
+          Dst.Texels.resize((UINT_PTR)Dst.W * Dst.H);
+          for (INT y = 0; y < Dst.H; y++)
+            for (INT x = 0; x < Dst.W; x++)
+            {
+              INT
+                x0 = (std::min)(2 * x, Src.W - 1), x1 = (std::min)(2 * x + 1, Src.W - 1),
+                y0 = (std::min)(2 * y, Src.H - 1), y1 = (std::min)(2 * y + 1, Src.H - 1);
+              DWORD
+                c[4] = {Src.Texels[(UINT_PTR)y0 * Src.W + x0], Src.Texels[(UINT_PTR)y0 * Src.W + x1],
+                        Src.Texels[(UINT_PTR)y1 * Src.W + x0], Src.Texels[(UINT_PTR)y1 * Src.W + x1]},
+                r = 0;
+
+              for (INT b = 0; b < 32; b += 8)
+                r |= ((((c[0] >> b) & 0xFF) + ((c[1] >> b) & 0xFF) +
+                       ((c[2] >> b) & 0xFF) + ((c[3] >> b) & 0xFF) + 2) / 4) << b;
+              Dst.Texels[(UINT_PTR)y * Dst.W + x] = r;
+            }
+          Levels.push_back(std::move(Dst));
         }
+      } /* End of 'BuildMips' function */
+
+      /* Delete texture function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Free()
+      {
+        Levels.clear();
+        FileName.clear();
       } /* End of '~texture' function */
 
       /* Texture destructor function */
@@ -132,6 +649,16 @@ namespace pirt
         Free();
       } /* End of '~texture' function */
 
+      /* Get mip levels count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) levels count (0 for empty texture).
+       */
+      INT LevelsCount( VOID ) const
+      {
+        return (INT)Resident().size();
+      } /* End of 'LevelsCount' function */
+
       /* Get color from texture function.
        * ARGUMENTS:
        *   - texture coordinates:
@@ -144,7 +671,7 @@ namespace pirt
         //std::swap(TC.X, TC.Y);
         TC.Y = 1 - TC.Y;
 
-        static auto F = []( DBL X ) -> DBL
+        static auto F = []( REAL X ) -> REAL
         {
           return X < 0 ? 0 : X > 1 ? 1 : X;
         };
@@ -154,20 +681,303 @@ namespace pirt
           return vec3(0);
 #endif // _DEBUG
 
-        DWORD color = Buf[(INT)round(F(TC.Y) * (H - 1)) * W + (INT)round(F(TC.X) * (W - 1))];
-        DWORD b = color & 0xFF;
-        DWORD g = (color & 0xFF00) >> 8;
-        DWORD r = (color & 0xFF0000) >> 16;
+        const std::vector<level> &Levels = Resident();
 
-        return vec3(r / 255., g / 255., b / 255.);
+        if (Levels.empty())
+          return vec3(0);
+        return Levels[0].Color((INT)round(F(TC.X) * (W - 1)), (INT)round(F(TC.Y) * (H - 1)));
       } /* End of 'GetColor' function */
+
+      /* Get filtered color from texture function.
+       * ARGUMENTS:
+       *   - texture coordinates (repeated out of [0, 1] for filtering modes):
+       *       vec2 TC;
+       *   - footprint width in texture coordinates (0 if not known):
+       *       REAL Footprint;
+       * RETURNS:
+       *   (vec3) color.
+       */
+      vec3 GetColor( vec2 TC, REAL Footprint ) const
+      {
+        if (Filter == NEAREST)
+          return GetColor(TC);
+
+        const std::vector<level> &Levels = Resident();
+
+        if (Levels.empty())
+          return vec3(0);
+        TC.Y = 1 - TC.Y;
+
+        // Level where footprint covers about one texel
+        REAL Lod = Footprint > 0 ? log2(Footprint * sqrt((REAL)W * H)) : 0;
+        INT Last = (INT)Levels.size() - 1;
+
+        Lod = std::clamp(Lod, (REAL)0, (REAL)Last);
+        if (Filter == BILINEAR)
+          return Bilinear(Levels[(INT)(Lod + 0.5)], TC);
+
+        INT L0 = (INT)Lod;
+        REAL t = Lod - L0;
+
+        if (t == 0 || L0 == Last)
+          return Bilinear(Levels[L0], TC);
+        return Bilinear(Levels[L0], TC) * (1 - t) + Bilinear(Levels[L0 + 1], TC) * t;
+      } /* End of 'GetColor' function */
+
+    private:
+      /* Get mip pyramid (decoded by cache for lazy texture) function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (const std::vector<level> &) levels (valid until next call by the same thread).
+       */
+      const std::vector<level> & Resident( VOID ) const;
+
+      /* Read and decode lazy texture texels function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (std::vector<level>) mip pyramid (empty if file is not read).
+       */
+      std::vector<level> Decode( VOID ) const
+      {
+        std::vector<BYTE> Buf((UINT_PTR)W * H * Channels);
+        FILE *F;
+
+        if ((F = fopen(FileName.c_str(), "rb")) == nullptr)
+          return {};
+        BOOL IsOk = fseek(F, (long)Offset, SEEK_SET) == 0 && fread(Buf.data(), 1, Buf.size(), F) == Buf.size();
+
+        fclose(F);
+        if (!IsOk)
+          return {};
+        return texture(W, H, Channels, Buf.data(), Num).Levels;
+      } /* End of 'Decode' function */
+
+      /* Convert texel to color function.
+       * ARGUMENTS:
+       *   - texel:
+       *       DWORD color;
+       * RETURNS:
+       *   (vec3) color.
+       */
+      static vec3 ToColor( DWORD color )
+      {
+        return vec3(Channel[(color >> 16) & 0xFF], Channel[(color >> 8) & 0xFF], Channel[color & 0xFF]);
+      } /* End of 'ToColor' function */
+
+      /* Get bilinear filtered level color (repeat addressing) function.
+       * ARGUMENTS:
+       *   - mip level:
+       *       const level &L;
+       *   - texture coordinates (Y is from top):
+       *       const vec2 &TC;
+       * RETURNS:
+       *   (vec3) color.
+       */
+      static vec3 Bilinear( const level &L, const vec2 &TC )
+      {
+        REAL
+          x = TC.X * L.W - 0.5, y = TC.Y * L.H - 0.5,
+          fx = floor(x), fy = floor(y), tx = x - fx, ty = y - fy;
+        auto Wrap =
+          []( REAL V, INT Size ) -> INT
+          {
+            INT i = (INT)fmod(V, (REAL)Size);
+
+            return i < 0 ? i + Size : i;
+          };
+        INT
+          x0 = Wrap(fx, L.W), x1 = x0 + 1 == L.W ? 0 : x0 + 1,
+          y0 = Wrap(fy, L.H), y1 = y0 + 1 == L.H ? 0 : y0 + 1;
+        UINT_PTR
+          ox0 = L.OffsetX(x0), ox1 = L.OffsetX(x1),
+          oy0 = L.OffsetY(y0), oy1 = L.OffsetY(y1);
+
+        if (!L.Colors.empty())
+        {
+          const fvec4 *T = L.Colors.data();
+          auto ToVec =
+            []( const fvec4 &C ) -> vec3
+            {
+              return vec3(C.X, C.Y, C.Z);
+            };
+
+          return (ToVec(T[ox0 + oy0]) * (1 - tx) + ToVec(T[ox1 + oy0]) * tx) * (1 - ty) +
+                 (ToVec(T[ox0 + oy1]) * (1 - tx) + ToVec(T[ox1 + oy1]) * tx) * ty;
+        }
+
+        DWORD c00, c10, c01, c11;
+
+        if (L.Blocks.empty())
+        {
+          const DWORD *T = L.Texels.data();
+
+          c00 = T[ox0 + oy0], c10 = T[ox1 + oy0], c01 = T[ox0 + oy1], c11 = T[ox1 + oy1];
+        }
+        else
+          c00 = L.Texel(x0, y0), c10 = L.Texel(x1, y0), c01 = L.Texel(x0, y1), c11 = L.Texel(x1, y1);
+
+        return (ToColor(c00) * (1 - tx) + ToColor(c10) * tx) * (1 - ty) +
+               (ToColor(c01) * (1 - tx) + ToColor(c11) * tx) * ty;
+      } /* End of 'Bilinear' function */
     }; /* End of 'texture' class */
 
+    /* Lazy textures decoded texels cache class */
+    class texture_cache
+    {
+    public:
+      /* Decoded mip pyramid reference type */
+      typedef std::shared_ptr<const std::vector<texture::level>> levels_ref;
+
+      UINT_PTR Budget = (UINT_PTR)256 << 20; // Decoded texels memory budget in bytes
+      std::atomic<UINT64>
+        Hits = 0,                   // Lookups of decoded textures count
+        Misses = 0,                 // Textures decodings count
+        Evictions = 0;              // Evicted textures count
+
+    private:
+      /* Cache entry class */
+      class entry
+      {
+      public:
+        levels_ref Levels;          // Decoded levels
+        UINT_PTR Size;              // Levels memory size
+        std::list<UINT64>::iterator Pos; // Position in usage list
+      };
+
+      std::mutex Mutex;             // Entries lock
+      std::map<UINT64, entry> Entries; // Decoded textures (by texture identifier)
+      std::list<UINT64> Lru;        // Textures identifiers (most recently used first)
+      UINT_PTR Size = 0;            // Decoded texels memory size
+
+    public:
+      /* Get lazy texture decoded levels function.
+       * ARGUMENTS:
+       *   - texture:
+       *       const texture &Tex;
+       * RETURNS:
+       *   (levels_ref) decoded levels.
+       */
+      levels_ref Get( const texture &Tex )
+      {
+        {
+          std::lock_guard<std::mutex> Lock(Mutex);
+
+          if (auto It = Entries.find(Tex.Id); It != Entries.end())
+          {
+            Hits++;
+            Lru.splice(Lru.begin(), Lru, It->second.Pos);
+            return It->second.Levels;
+          }
+        }
+
+        // Decoding is not locked, other thread may decode the same texture
+        Misses++;
+        levels_ref Levels = std::make_shared<const std::vector<texture::level>>(Tex.Decode());
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        if (auto It = Entries.find(Tex.Id); It != Entries.end())
+          return It->second.Levels;
+        Lru.push_front(Tex.Id);
+        UINT_PTR NewSize = texture::MemorySize(*Levels);
+
+        Entries[Tex.Id] = {Levels, NewSize, Lru.begin()};
+        Size += NewSize;
+        // Evicted levels live while some thread uses them
+        while (Size > Budget && Lru.size() > 1)
+        {
+          auto It = Entries.find(Lru.back());
+
+          Size -= It->second.Size;
+          Entries.erase(It);
+          Lru.pop_back();
+          Evictions++;
+        }
+        return Levels;
+      } /* End of 'Get' function */
+
+      /* Remove texture from cache function.
+       * ARGUMENTS:
+       *   - texture:
+       *       const texture &Tex;
+       * RETURNS: None.
+       */
+      VOID Remove( const texture &Tex )
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        if (auto It = Entries.find(Tex.Id); It != Entries.end())
+        {
+          Size -= It->second.Size;
+          Lru.erase(It->second.Pos);
+          Entries.erase(It);
+        }
+      } /* End of 'Remove' function */
+
+      /* Clear cache function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Clear( VOID )
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        Entries.clear();
+        Lru.clear();
+        Size = 0;
+      } /* End of 'Clear' function */
+
+      /* Get decoded texels memory size function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (UINT_PTR) size in bytes.
+       */
+      UINT_PTR MemorySize( VOID )
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        return Size;
+      } /* End of 'MemorySize' function */
+    }; /* End of 'texture_cache' class */
+
+    /* Global variable with lazy textures cache */
+    inline texture_cache TexCache {};
+
+    /* Get mip pyramid (decoded by cache for lazy texture) function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const std::vector<level> &) levels (valid until next call by the same thread).
+     */
+    inline const std::vector<texture::level> & texture::Resident( VOID ) const
+    {
+      /* Thread last used lazy texture class */
+      class memo
+      {
+      public:
+        UINT64 Id = 0;              // Texture identifier
+        texture_cache::levels_ref Levels; // Texture levels
+      };
+      static thread_local memo Memo[4];
+      static thread_local INT Next = 0;
+
+      if (!IsLazy() || !Levels.empty())
+        return Levels;
+      for (auto &M : Memo)
+        if (M.Id == Id)
+          return *M.Levels;
+      memo &M = Memo[Next];
+
+      Next = (Next + 1) % 4;
+      M.Levels = TexCache.Get(*this);
+      M.Id = Id;
+      return *M.Levels;
+    } /* End of 'texture::Resident' function */
+
     /* Texture manager class */
     class texture_manager
     {
     public:
       INT TexCount;                 // Total count of all textures, needing for set unique number for every textures.
+      BOOL IsLazy = FALSE;          // Add file textures as lazy (decoded on demand) flag
       std::map<INT, texture> Stock; // Texture stock
 
       /* Default constructor */
@@ -188,8 +998,24 @@ namespace pirt
        */
       texture * AddTexture( INT W, INT H, INT C, const VOID *Buf )
       {
-        texture tex{W, H, C, Buf, TexCount};
-        return &(Stock.insert({TexCount++, tex}).first->second);
+        // Texture is built in place (no texels copies)
+        texture *Tex = &Stock.try_emplace(TexCount, W, H, C, Buf, TexCount).first->second;
+
+        TexCount++;
+        return Tex;
+      } /* End of 'AddTexture' function */
+
+      /* Add (move) ready texture function.
+       * ARGUMENTS:
+       *   - texture:
+       *       texture &&Tex;
+       * RETURNS:
+       *   (texture *) stored texture.
+       */
+      texture * AddTexture( texture &&Tex )
+      {
+        Tex.Num = TexCount;
+        return &Stock.try_emplace(TexCount++, std::move(Tex)).first->second;
       } /* End of 'AddTexture' function */
 
       /* Add texture function.
@@ -205,12 +1031,45 @@ namespace pirt
        */
       INT AddTextureNo( INT W, INT H, INT C, const VOID *Buf )
       {
-        texture tex {W, H, C, Buf, TexCount};
-        Stock.insert({TexCount, tex});
+        Stock.try_emplace(TexCount, W, H, C, Buf, TexCount);
 
         return TexCount++;
       } /* End of 'AddTextureNo' function */
 
+      /* Add lazy (decoded on first lookup) texture function.
+       * ARGUMENTS:
+       *   - source file name and texels offset in it:
+       *       const std::string &FileName;
+       *       UINT_PTR Offset;
+       *   - size:
+       *       INT W, INT H;
+       *   - count of bytes to one pixel:
+       *       INT C;
+       * RETURNS:
+       *   (texture *) new texture.
+       */
+      texture * AddLazyTexture( const std::string &FileName, UINT_PTR Offset, INT W, INT H, INT C )
+      {
+        texture *Tex = &Stock.try_emplace(TexCount, FileName, Offset, W, H, C, TexCount).first->second;
+
+        TexCount++;
+        return Tex;
+      } /* End of 'AddLazyTexture' function */
+
+      /* Get all textures texels memory size function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (UINT_PTR) size in bytes.
+       */
+      UINT_PTR MemorySize( VOID ) const
+      {
+        UINT_PTR Size = 0;
+
+        for (auto &[No, Tex] : Stock)
+          Size += Tex.MemorySize();
+        return Size;
+      } /* End of 'MemorySize' function */
+
       /* Get texture by number in stock function.
        * ARGUMENTS:
        *   - number of texture:
@@ -235,6 +1094,8 @@ namespace pirt
        */
       VOID DeleteTexture( texture *Tex )
       {
+        if (Tex->IsLazy())
+          TexCache.Remove(*Tex);
         Tex->Free();
 
         if (auto find_entry = Stock.find(Tex->Num); 
@@ -248,6 +1109,7 @@ namespace pirt
        */
       VOID Clear( VOID )
       {
+        TexCache.Clear();
         Stock.clear();
         TexCount = 0;
       } /* End of 'Clear' function */
@@ -0,0 +1,171 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        thread_pool.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's persistent render threads pool header file.
+ * NOTE:        Threads are created once and stay asleep between jobs,
+ *              so consecutive renders (animation frames, previews) do
+ *              not pay threads startup cost.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __thread_pool_h_
+#define __thread_pool_h_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+#include "def.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Persistent threads pool class */
+    class thread_pool
+    {
+    private:
+      std::vector<std::thread> Threads;       // Pool threads
+      std::mutex Mutex;                       // Job state access mutex
+      std::mutex RunMutex;                    // Job running serialization mutex
+      std::condition_variable WakeUp, Done;   // Job start and finish events
+      std::function<VOID( INT )> Job;         // Current job
+      UINT_PTR JobNo = 0;                     // Current job number
+      INT ActiveCount = 0;                    // Count of threads which still run job
+      BOOL IsExit = FALSE;                    // Threads exit flag
+
+      /* Pool thread main function.
+       * ARGUMENTS:
+       *   - thread number:
+       *       INT No;
+       *   - last seen job number:
+       *       UINT_PTR SeenJobNo;
+       * RETURNS: None.
+       */
+      VOID ThreadMain( INT No, UINT_PTR SeenJobNo )
+      {
+        std::unique_lock<std::mutex> Lock(Mutex);
+
+        while (TRUE)
+        {
+          WakeUp.wait(Lock, [&]( VOID ){ return IsExit || JobNo != SeenJobNo; });
+          if (IsExit)
+            return;
+          SeenJobNo = JobNo;
+
+          // Job is not changed until all threads finish it
+          Lock.unlock();
+          Job(No);
+          Lock.lock();
+          if (--ActiveCount == 0)
+            Done.notify_all();
+        }
+      } /* End of 'ThreadMain' function */
+
+    public:
+      /* Default constructor */
+      thread_pool( VOID )
+      {
+      } /* End of 'thread_pool' function */
+
+      /* Default destructor */
+      ~thread_pool( VOID )
+      {
+        Stop();
+      } /* End of '~thread_pool' function */
+
+      /* Get pool threads count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) threads count.
+       */
+      INT Size( VOID ) const
+      {
+        return (INT)Threads.size();
+      } /* End of 'Size' function */
+
+      /* Start (or restart with other size) pool threads function.
+       * ARGUMENTS:
+       *   - threads count:
+       *       INT Count;
+       * RETURNS: None.
+       */
+      VOID Start( INT Count )
+      {
+        const std::lock_guard<std::mutex> RunLock(RunMutex);
+
+        if (Count == (INT)Threads.size())
+          return;
+        StopThreads();
+        IsExit = FALSE;
+        for (INT i = 0; i < Count; i++)
+          Threads.push_back(std::thread(&thread_pool::ThreadMain, this, i, JobNo));
+      } /* End of 'Start' function */
+
+      /* Stop pool threads function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Stop( VOID )
+      {
+        const std::lock_guard<std::mutex> RunLock(RunMutex);
+
+        StopThreads();
+      } /* End of 'Stop' function */
+
+      /* Run job on all pool threads and wait its finish function.
+       * ARGUMENTS:
+       *   - job (gets thread number in pool):
+       *       const std::function<VOID( INT )> &NewJob;
+       * RETURNS: None.
+       */
+      VOID Run( const std::function<VOID( INT )> &NewJob )
+      {
+        const std::lock_guard<std::mutex> RunLock(RunMutex);
+        std::unique_lock<std::mutex> Lock(Mutex);
+
+        if (Threads.empty())
+          return;
+        Job = NewJob;
+        ActiveCount = (INT)Threads.size();
+        JobNo++;
+        WakeUp.notify_all();
+        Done.wait(Lock, [&]( VOID ){ return ActiveCount == 0; });
+        Job = nullptr;
+      } /* End of 'Run' function */
+
+    private:
+      /* Stop and join all threads function (run mutex is locked).
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID StopThreads( VOID )
+      {
+        {
+          const std::lock_guard<std::mutex> Lock(Mutex);
+
+          IsExit = TRUE;
+        }
+        WakeUp.notify_all();
+        for (auto &Th : Threads)
+          Th.join();
+        Threads.clear();
+      } /* End of 'StopThreads' function */
+    }; /* End of 'thread_pool' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__thread_pool_h_
+
+/* END OF 'thread_pool.h' FILE */
@@ -0,0 +1,242 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        tiles.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 18.10.2026
+ * PURPOSE:     RayTracing's frame tiles partition header file.
+ * NOTE:        Tiles are numbered row by row, from left-top corner.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __tiles_h_
+#define __tiles_h_
+
+#include <vector>
+#include <algorithm>
+
+#include "def.h"
+
+/* Base project namespace */
+namespace pirt
+{
+  /* Ray tracing namespace */
+  namespace rt
+  {
+    /* Frame tile (rectangle) class */
+    class tile
+    {
+    public:
+      INT No;           // Tile number in grid
+      INT X0, Y0;       // Left-top pixel of tile
+      INT W, H;         // Tile size (clipped by frame)
+    }; /* End of 'tile' class */
+
+    /* Frame tiles grid class */
+    class tile_grid
+    {
+    public:
+      INT
+        FrameW, FrameH, // Frame size
+        Size,           // Tile side size
+        CountX, CountY; // Tiles count by X and Y
+
+      /* Constructor by frame size.
+       * ARGUMENTS:
+       *   - frame size:
+       *       INT NewFrameW, NewFrameH;
+       *   - tile side size:
+       *       INT TileSize;
+       */
+      tile_grid( INT NewFrameW, INT NewFrameH, INT TileSize = 32 ) :
+        FrameW(NewFrameW), FrameH(NewFrameH), Size(TileSize < 1 ? 1 : TileSize)
+      {
+        CountX = (FrameW + Size - 1) / Size;
+        CountY = (FrameH + Size - 1) / Size;
+      } /* End of 'tile_grid' function */
+
+      /* Get tiles count function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) tiles count.
+       */
+      INT Count( VOID ) const
+      {
+        return CountX * CountY;
+      } /* End of 'Count' function */
+
+      /* Get tile by number function.
+       * ARGUMENTS:
+       *   - tile number:
+       *       INT No;
+       * RETURNS:
+       *   (tile) tile rectangle.
+       */
+      tile operator[]( INT No ) const
+      {
+        tile T;
+
+        T.No = No;
+        T.X0 = No % CountX * Size;
+        T.Y0 = No / CountX * Size;
+        T.W = T.X0 + Size > FrameW ? FrameW - T.X0 : Size;
+        T.H = T.Y0 + Size > FrameH ? FrameH - T.Y0 : Size;
+        return T;
+      } /* End of 'operator[]' function */
+    }; /* End of 'tile_grid' class */
+
+    /* Shapes and space referenced by tile rays class */
+    class tile_refs
+    {
+    public:
+      BOOL IsValid = FALSE;               // References are collected by whole tile render flag
+      std::vector<bool> Shapes;           // Hit shapes (by number in scene) set
+      BOOL IsSeg = FALSE;                 // Secondary finite segments exist flag
+      vec3 SegMin, SegMax;                // Secondary finite segments bound box
+      BOOL IsEscape = FALSE;              // Secondary escaped (infinite) rays exist flag
+      vec3
+        OrgMin, OrgMax,                   // Escaped rays origins bound box
+        DirMin, DirMax;                   // Escaped rays directions bound box
+
+      /* Clear references function.
+       * ARGUMENTS:
+       *   - scene shapes count:
+       *       INT ShapesCount;
+       * RETURNS: None.
+       */
+      VOID Reset( INT ShapesCount )
+      {
+        Shapes.assign(ShapesCount, false);
+        IsSeg = IsEscape = FALSE;
+        IsValid = TRUE;
+      } /* End of 'Reset' function */
+
+      /* Add hit shape function.
+       * ARGUMENTS:
+       *   - shape number:
+       *       INT No;
+       * RETURNS: None.
+       */
+      VOID AddShape( INT No )
+      {
+        if (No >= 0 && No < (INT)Shapes.size())
+          Shapes[No] = true;
+      } /* End of 'AddShape' function */
+
+      /* Check if shape was hit function.
+       * ARGUMENTS:
+       *   - shape number:
+       *       INT No;
+       * RETURNS:
+       *   (BOOL) TRUE if shape was hit by tile rays, FALSE otherwise.
+       */
+      BOOL IsTouched( INT No ) const
+      {
+        return No >= 0 && No < (INT)Shapes.size() && Shapes[No];
+      } /* End of 'IsTouched' function */
+
+      /* Add secondary ray finite segment function.
+       * ARGUMENTS:
+       *   - segment ends:
+       *       const vec3 &A, &B;
+       * RETURNS: None.
+       */
+      VOID AddSegment( const vec3 &A, const vec3 &B )
+      {
+        if (!IsSeg)
+          SegMin = SegMax = A, IsSeg = TRUE;
+        Expand(&SegMin, &SegMax, A);
+        Expand(&SegMin, &SegMax, B);
+      } /* End of 'AddSegment' function */
+
+      /* Add secondary escaped (not hit) ray function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray &R;
+       * RETURNS: None.
+       */
+      VOID AddEscape( const ray &R )
+      {
+        if (!IsEscape)
+          OrgMin = OrgMax = R.Org, DirMin = DirMax = R.Dir, IsEscape = TRUE;
+        Expand(&OrgMin, &OrgMax, R.Org);
+        Expand(&DirMin, &DirMax, R.Dir);
+      } /* End of 'AddEscape' function */
+
+      /* Check if secondary rays may reach bound box function.
+       * ARGUMENTS:
+       *   - bound box:
+       *       const vec3 &Min, &Max;
+       * RETURNS:
+       *   (BOOL) TRUE if box may be reached (conservative), FALSE otherwise.
+       */
+      BOOL IsReachable( const vec3 &Min, const vec3 &Max ) const
+      {
+        if (IsSeg &&
+            SegMin.X <= Max.X && SegMax.X >= Min.X &&
+            SegMin.Y <= Max.Y && SegMax.Y >= Min.Y &&
+            SegMin.Z <= Max.Z && SegMax.Z >= Min.Z)
+          return TRUE;
+        if (!IsEscape)
+          return FALSE;
+
+        // Escaped rays family points at t >= 0 lie in [OrgMin + t * DirMin, OrgMax + t * DirMax]
+        REAL T0 = 0, T1 = HUGE_VAL;
+
+        return
+          Clip(OrgMin.X, DirMin.X, Max.X, TRUE, &T0, &T1) && Clip(OrgMax.X, DirMax.X, Min.X, FALSE, &T0, &T1) &&
+          Clip(OrgMin.Y, DirMin.Y, Max.Y, TRUE, &T0, &T1) && Clip(OrgMax.Y, DirMax.Y, Min.Y, FALSE, &T0, &T1) &&
+          Clip(OrgMin.Z, DirMin.Z, Max.Z, TRUE, &T0, &T1) && Clip(OrgMax.Z, DirMax.Z, Min.Z, FALSE, &T0, &T1);
+      } /* End of 'IsReachable' function */
+
+    private:
+      /* Expand bound box by point function.
+       * ARGUMENTS:
+       *   - bound box:
+       *       vec3 *Min, *Max;
+       *   - point:
+       *       const vec3 &P;
+       * RETURNS: None.
+       */
+      static VOID Expand( vec3 *Min, vec3 *Max, const vec3 &P )
+      {
+        *Min = vec3((std::min)(Min->X, P.X), (std::min)(Min->Y, P.Y), (std::min)(Min->Z, P.Z));
+        *Max = vec3((std::max)(Max->X, P.X), (std::max)(Max->Y, P.Y), (std::max)(Max->Z, P.Z));
+      } /* End of 'Expand' function */
+
+      /* Clip parameter range by linear inequality function.
+       * ARGUMENTS:
+       *   - inequality O + t * D <= B (IsLess) or O + t * D >= B (!IsLess) coefficients:
+       *       REAL O, D, B;
+       *       BOOL IsLess;
+       *   - parameter range:
+       *       REAL *T0, *T1;
+       * RETURNS:
+       *   (BOOL) FALSE if range becomes empty, TRUE otherwise.
+       */
+      static BOOL Clip( REAL O, REAL D, REAL B, BOOL IsLess, REAL *T0, REAL *T1 )
+      {
+        if (!IsLess)
+          O = -O, D = -D, B = -B;
+        if (D == 0)
+          return O <= B;
+
+        REAL t = (B - O) / D;
+
+        if (D > 0)
+          *T1 = (std::min)(*T1, t);
+        else
+          *T0 = (std::max)(*T0, t);
+        return *T0 <= *T1;
+      } /* End of 'Clip' function */
+    }; /* End of 'tile_refs' class */
+  } /* end of 'rt' namespace */
+} /* end of 'pirt' namespace */
+
+#endif // !__tiles_h_
+
+/* END OF 'tiles.h' FILE */